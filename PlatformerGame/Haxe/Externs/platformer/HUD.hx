@@ -6,7 +6,7 @@ import unreal.*;
 @:umodule("PlatformerGame")
 @:uextern extern class HUD extends AHUD {
   function NotifyRoundTimeModified(DeltaTime:Float32):Void;
-  function AddMessage(message:FString, displayDuration:Float32, posX:Float32, posY:Float32, textScale:Float32, bRedBorder:Bool):Void;
+  function AddMessage(message:Const<PRef<FString>>, displayDuration:Float32, posX:Float32, posY:Float32, textScale:Float32, bRedBorder:Bool):Void;
   function ShowHighscore(Times:TArray<Float32>, Names:TArray<FString>):Void;
   function HideHighscore():Void;
   function ShowHighscorePrompt():Void;
@@ -0,0 +1,12 @@
+package platformer;
+import unreal.*;
+
+@:glueCppIncludes("PlatformerLeaderboard.h")
+@:uname("UPlatformerLeaderboardLibrary")
+@:umodule("PlatformerGame")
+@:uextern extern class LeaderboardLibrary extends UBlueprintFunctionLibrary {
+  static function PreloadRecords():Void;
+  static function LoadBestCheckpointTimes(OutTimes:PRef<TArray<Float32>>):Void;
+  static function SaveRun(CheckpointTimes:Const<PRef<TArray<Float32>>>):Void;
+  static function SortHighscores(InTimes:Const<PRef<TArray<Float32>>>, InNames:Const<PRef<TArray<FString>>>, OutTimes:PRef<TArray<Float32>>, OutNames:PRef<TArray<FString>>, MaxScores:Int32):Void;
+}
@@ -0,0 +1,9 @@
+package platformer;
+import unreal.*;
+
+@:glueCppIncludes("UI/PlatformerTimeFormat.h")
+@:uname("FPlatformerTimeFormat")
+@:umodule("PlatformerGame")
+@:uextern extern class TimeFormat {
+  static function Describe(TimeSeconds:Float32, bShowSign:Bool):FString;
+}
@@ -0,0 +1,11 @@
+package platformer;
+import unreal.*;
+
+@:glueCppIncludes("PlatformerTrace.h")
+@:uname("FPlatformerTrace")
+@:umodule("PlatformerGameLoadingScreen")
+@:uextern extern class Trace {
+  static function IsEnabled():Bool;
+  static function BeginEvent(Name:FName):Void;
+  static function EndEvent():Void;
+}
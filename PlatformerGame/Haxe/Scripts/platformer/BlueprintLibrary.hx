@@ -2,7 +2,6 @@ package platformer;
 import unreal.*;
 
 using unreal.CoreAPI;
-using StringTools;
 
 @:uclass
 @:uname("UPlatformerBlueprintLibrary")
@@ -134,21 +133,8 @@ class BlueprintLibrary extends UBlueprintFunctionLibrary {
   /** converts time to string in mm:ss.sss format */
   @:ufunction(BlueprintPure, Category=HUD)
   public static function DescribeTime(TimeSeconds:Float32, bShowSign:Bool = true):FString {
-    var AbsTimeSeconds = Math.abs(TimeSeconds);
-    var bIsNegative = (TimeSeconds < 0);
-
-    var TotalSeconds = Std.int(AbsTimeSeconds) % 3600;
-    var NumMinutes = Std.int(TotalSeconds / 60);
-    var NumSeconds = Std.int(TotalSeconds % 60);
-
-    var NumMiliSeconds = Std.int( (AbsTimeSeconds * 1000.0) % 1000 );
-
-    var TimeDesc = (bShowSign ? (bIsNegative ? '-' : '+') : '') +
-        Std.string(NumMinutes).lpad('0',2) + ':' +
-        Std.string(NumSeconds).lpad('0',2) + '.' +
-        Std.string(NumMiliSeconds).lpad('0',3);
-
-    return TimeDesc;
+    // formatted natively, the HUD uses the same formatter every frame
+    return TimeFormat.Describe(TimeSeconds, bShowSign);
   }
 
   /** displays specified texture covering entire screen */
@@ -223,13 +209,7 @@ class BlueprintLibrary extends UBlueprintFunctionLibrary {
    */
   @:ufunction(BlueprintCallable, Category = Game)
   public static function SortHighscores(InTimes:TArray<Float32>, InNames:TArray<FString>, OutTimes:PRef<TArray<Float32>>, OutNames:PRef<TArray<FString>>, MaxScores:Int32):Void {
-    var tmp = [ for (i in 0...InTimes.Num()) { time:InTimes[i], name:InNames[i] } ];
-    tmp.sort(function(e1, e2) return Reflect.compare(e1.time, e2.time));
-    OutTimes.Empty();
-    OutNames.Empty();
-    for (i in 0...tmp.length) {
-      OutTimes.Push( tmp[i].time );
-      OutNames.Push( tmp[i].name );
-    }
+    // native leaderboard keeps the best MaxScores, binary searching each insert
+    LeaderboardLibrary.SortHighscores(InTimes, InNames, OutTimes, OutNames, MaxScores);
   }
 }
@@ -53,9 +53,16 @@ class GameMode extends AGameMode {
   /** best checkpoint times */
   @:uexpose var BestTimes:TArray<Float32>;
 
+  /** true once BestTimes were read from the record store */
+  var bBestTimesLoaded:Bool;
+
   // All UObject-derived constructors take a `wrapped` argument, which should be passed to the `super` constructor
   public function new(wrapped) {
     super(wrapped);
+    var bTrace = Trace.IsEnabled();
+    if (bTrace) {
+      Trace.BeginEvent("APlatformerGameMode::APlatformerGameMode");
+    }
 
     PlayerControllerClass = PlayerController.StaticClass();
     var PlayerPawnClass:FClassFinder<APawn> = FClassFinder.Find("/Game/Pawn/PlayerPawn");
@@ -68,6 +75,16 @@ class GameMode extends AGameMode {
     if (UEngine.GEngine != null && UEngine.GEngine.GameViewport != null) {
       UEngine.GEngine.GameViewport.SetSuppressTransitionMessage(true);
     }
+
+    if (bTrace) {
+      Trace.EndEvent();
+    }
+  }
+
+  override public function BeginPlay():Void {
+    super.BeginPlay();
+    // read on a pool thread while the intro plays, so the first checkpoint doesn't wait for the disk
+    LeaderboardLibrary.PreloadRecords();
   }
 
   inline private function getPC():PlayerController {
@@ -107,6 +124,7 @@ class GameMode extends AGameMode {
   /** finish current round */
   @:uexpose public function FinishRound():Void {
     MyGameState = Finished;
+    LoadBestTimes();
 
     // determine game state
     var LastCheckpointIdx = GetNumCheckpoints() - 1;
@@ -127,13 +145,26 @@ class GameMode extends AGameMode {
       BestTimes.Push(-1);
     }
 
-    for (i in 0...BestTimes.Num())
+    // checkpoints missed in this run are -1 and never replace a best time
+    var NumTimes = BestTimes.Num() < CurrentTimes.Num() ? BestTimes.Num() : CurrentTimes.Num();
+    for (i in 0...NumTimes)
     {
-      if ((BestTimes[i] < 0) || (BestTimes[i] > CurrentTimes[i]))
+      if ((CurrentTimes[i] >= 0) && ((BestTimes[i] < 0) || (BestTimes[i] > CurrentTimes[i])))
       {
         BestTimes[i] = CurrentTimes[i];
       }
     }
+
+    // appended to the record log in the background
+    LeaderboardLibrary.SaveRun(CurrentTimes);
+  }
+
+  /** reads best checkpoint times saved by previous sessions, on first use only */
+  private function LoadBestTimes():Void {
+    if (!bBestTimesLoaded) {
+      bBestTimesLoaded = true;
+      LeaderboardLibrary.LoadBestCheckpointTimes(BestTimes);
+    }
   }
 
   /** pauses/unpauses the game */
@@ -188,6 +219,7 @@ class GameMode extends AGameMode {
 
   /** get checkpoint time: best */
   public function GetBestCheckpointTime(CheckpointID:Int32):Float32 {
+    LoadBestTimes();
     return CheckpointID >= 0 && CheckpointID < BestTimes.Num() ? BestTimes[CheckpointID] : -1;
   }
 
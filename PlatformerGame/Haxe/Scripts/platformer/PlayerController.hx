@@ -18,12 +18,9 @@ class PlayerController extends APlayerController {
   override public function PostInitializeComponents() {
     super.PostInitializeComponents();
 
-    //Build menu only after game is initialized
     // @note Initialize in FPlatformerGameModule::StartupModule is not enough - it won't execute in cooked game
+    // the menu itself is built the first time it's opened, most levels are played without it
     IGameMenuBuilderModule.Get();
-    PlatformerIngameMenu = FPlatformerIngameMenu.createNew().toSharedPtr();
-    PlatformerIngameMenu.Get().MakeMenu(this);
-
   }
 
   @:ufunction(BlueprintCallable, Category="Game")
@@ -49,8 +46,13 @@ class PlayerController extends APlayerController {
 
   @:uexpose function OnToggleInGameMenu() {
     var MyGame = GetWorld().GetAuthGameMode().as(GameMode);
-    if (PlatformerIngameMenu.IsValid() && MyGame != null && MyGame.GetGameState() != Finished)
+    if (MyGame != null && MyGame.GetGameState() != Finished)
     {
+      if (PlatformerIngameMenu == null || !PlatformerIngameMenu.IsValid())
+      {
+        PlatformerIngameMenu = FPlatformerIngameMenu.createNew().toSharedPtr();
+        PlatformerIngameMenu.Get().MakeMenu(this);
+      }
       PlatformerIngameMenu.Get().ToggleGameMenu();
     }
   }
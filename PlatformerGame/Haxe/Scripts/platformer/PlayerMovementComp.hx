@@ -22,6 +22,8 @@ class PlayerMovementComp extends UCharacterMovementComponent {
 
     ModSpeedObstacleHit = 0.0;
     ModSpeedLedgeGrab = 0.8;
+
+    CeilingSweepDistance = 1000.0;
   }
 
   /** stop slide when falling */
@@ -186,6 +188,7 @@ class PlayerMovementComp extends UCharacterMovementComponent {
     if (!bInSlide)
     {
       bInSlide = true;
+      bCeilingCached = false;
       CurrentSlideVelocityReduction = 0.0;
       SetSlideCollisionHeight();
 
@@ -233,9 +236,15 @@ class PlayerMovementComp extends UCharacterMovementComponent {
       return false;
     }
 
-    var DefCharacter = CharacterOwner.GetClass().GetDefaultObject(new TypeParam<ACharacter>());
-    var DefHalfHeight = DefCharacter.GetCapsuleComponent().GetUnscaledCapsuleHalfHeight();
-    var DefRadius = DefCharacter.GetCapsuleComponent().GetUnscaledCapsuleRadius();
+    // default capsule size never changes, read it from the class default object once
+    if (DefaultCapsuleHalfHeight <= 0.0)
+    {
+      var DefCapsule = CharacterOwner.GetClass().GetDefaultObject(new TypeParam<ACharacter>()).GetCapsuleComponent();
+      DefaultCapsuleHalfHeight = DefCapsule.GetUnscaledCapsuleHalfHeight();
+      DefaultCapsuleRadius = DefCapsule.GetUnscaledCapsuleRadius();
+    }
+    var DefHalfHeight = DefaultCapsuleHalfHeight;
+    var DefRadius = DefaultCapsuleRadius;
 
     // Do not perform if collision is already at desired size.
     if (CharacterOwner.GetCapsuleComponent().GetUnscaledCapsuleHalfHeight() == DefHalfHeight)
@@ -243,17 +252,27 @@ class PlayerMovementComp extends UCharacterMovementComponent {
       return true;
     }
 
+    // the ceiling was measured by the last failed test, nothing changes until the runner gets past its end
+    var Location = CharacterOwner.GetActorLocation();
+    if (bCeilingCached && Location.X >= CeilingBlockedX && Location.X < CeilingClearX)
+    {
+      return false;
+    }
+    bCeilingCached = false;
+
     var HeightAdjust = DefHalfHeight - CharacterOwner.GetCapsuleComponent().GetUnscaledCapsuleHalfHeight();
-    var NewLocation = CharacterOwner.GetActorLocation() + new FVector(0.0, 0.0, HeightAdjust);
+    var NewLocation = Location + new FVector(0.0, 0.0, HeightAdjust);
 
     // check if there is enough space for default capsule size
     var TraceParams = FCollisionQueryParams.createWithParams("FinishSlide", false, CharacterOwner);
     var ResponseParam = FCollisionResponseParams.create();
     InitCollisionParams(TraceParams, ResponseParam);
-    // var bBlocked = GetWorld().OverlapBlockingTestByChannel(NewLocation, FQuat.Identity, UpdatedPrimitive.GetCollisionObjectType(), FCollisionShape.MakeCapsule(DefRadius, DefHalfHeight), TraceParams, ResponseParam);
-    var bBlocked = GetWorld().OverlapBlockingTestByChannel(NewLocation, FQuat.Identity, UpdatedPrimitive.GetCollisionObjectType(), FCollisionShape.MakeCapsule(DefRadius, DefHalfHeight), TraceParams, FCollisionResponseParams.DefaultResponseParam);
+    var CapsuleShape = FCollisionShape.MakeCapsule(DefRadius, DefHalfHeight);
+    // var bBlocked = GetWorld().OverlapBlockingTestByChannel(NewLocation, FQuat.Identity, UpdatedPrimitive.GetCollisionObjectType(), CapsuleShape, TraceParams, ResponseParam);
+    var bBlocked = GetWorld().OverlapBlockingTestByChannel(NewLocation, FQuat.Identity, UpdatedPrimitive.GetCollisionObjectType(), CapsuleShape, TraceParams, FCollisionResponseParams.DefaultResponseParam);
     if (bBlocked)
     {
+      CacheCeilingEnd(Location, NewLocation, CapsuleShape, TraceParams);
       return false;
     }
 
@@ -264,12 +283,61 @@ class PlayerMovementComp extends UCharacterMovementComponent {
     // restoring original PawnOwner mesh relative location
     if (bWantsSlideMeshRelativeLocationOffset)
     {
+      var DefCharacter = CharacterOwner.GetClass().GetDefaultObject(new TypeParam<ACharacter>());
       CharacterOwner.GetMesh().SetRelativeLocation(DefCharacter.GetMesh().RelativeLocation, false, null, None);
     }
 
     return true;
   }
 
+  /**
+   * finds where the ceiling blocking the standing capsule at BlockedLocation ends, so tests can be skipped until then
+   * pawn only runs along +X, so every component blocking the standing capsule is swept back from ahead of the pawn: its first hit is its end.
+   * Components the sliding capsule touches as well (floor, walls) aren't the ceiling, nothing is cached while one of them blocks
+   */
+  function CacheCeilingEnd(Location:FVector, BlockedLocation:FVector, CapsuleShape:Const<PRef<FCollisionShape>>, TraceParams:Const<PRef<FCollisionQueryParams>>) {
+    var Overlaps:TArray<FOverlapResult> = TArray.create();
+    GetWorld().OverlapMultiByChannel(Overlaps, BlockedLocation, FQuat.Identity, UpdatedPrimitive.GetCollisionObjectType(), CapsuleShape, TraceParams, FCollisionResponseParams.DefaultResponseParam);
+
+    var SlideCapsule = PawnOwner.as(ACharacter).GetCapsuleComponent();
+    var SlideShape = FCollisionShape.MakeCapsule(SlideCapsule.GetUnscaledCapsuleRadius(), SlideCapsule.GetUnscaledCapsuleHalfHeight());
+    var SweepStart = BlockedLocation + new FVector(CeilingSweepDistance, 0.0, 0.0);
+    var ClearX = BlockedLocation.X;
+    for (i in 0...Overlaps.Num())
+    {
+      var Component = Overlaps[i].GetComponent();
+      if (!Overlaps[i].bBlockingHit || Component == null)
+      {
+        continue;
+      }
+      if (Component.OverlapComponent(Location, FQuat.Identity, SlideShape))
+      {
+        return;
+      }
+
+      var Hit = new FHitResult(ForceInit);
+      if (!Component.SweepComponent(Hit, SweepStart, BlockedLocation, CapsuleShape, TraceParams.bTraceComplex))
+      {
+        // only grazing, tested again next time anyway
+        continue;
+      }
+
+      // a sweep starting blocked means the ceiling is longer than CeilingSweepDistance, measure again at the end of the swept range
+      var EndX = Hit.bStartPenetrating ? SweepStart.X : Hit.Location.X;
+      if (EndX > ClearX)
+      {
+        ClearX = EndX;
+      }
+    }
+
+    if (ClearX > BlockedLocation.X)
+    {
+      CeilingBlockedX = BlockedLocation.X;
+      CeilingClearX = ClearX;
+      bCeilingCached = true;
+    }
+  }
+
   /** speed multiplier after hiting an obstacle */
   @:uproperty(EditDefaultsOnly, Category=Config)
   var ModSpeedObstacleHit:Float32;
@@ -294,6 +362,10 @@ class PlayerMovementComp extends UCharacterMovementComponent {
   @:uproperty(EditDefaultsOnly, Category=Config)
   var SlideHeight:Float32;
 
+  /** how far ahead the end of a low ceiling is looked for when slide can't end */
+  @:uproperty(EditDefaultsOnly, Category=Config)
+  var CeilingSweepDistance:Float32;
+
   /** offset value, by which relative location of pawn mesh needs to be changed, when pawn is sliding */
   var SlideMeshRelativeLocationOffset:FVector;
 
@@ -308,4 +380,17 @@ class PlayerMovementComp extends UCharacterMovementComponent {
 
   /** true if pawn needs to use SlideMeshRelativeLocationOffset while sliding */
   var bWantsSlideMeshRelativeLocationOffset:Bool;
+
+  /** capsule size of the class default object, read on first slide end */
+  var DefaultCapsuleHalfHeight:Float32;
+  var DefaultCapsuleRadius:Float32;
+
+  /** true if a failed attempt to end slide measured the ceiling above pawn */
+  var bCeilingCached:Bool;
+
+  /** X of the failed attempt to end slide */
+  var CeilingBlockedX:Float32;
+
+  /** X from which the ceiling above pawn no longer blocks standing up */
+  var CeilingClearX:Float32;
 }
@@ -0,0 +1,23 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "FootIKBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures how foot placement IK scales with character count, without a GPU or the editor UI:
+ *   UE4Editor-Cmd PlatformerGame -run=FootIKBenchmark -nullrhi [-Map=] [-Pawn=] [-Counts=1,10,100,500] [-Frames=300] [-Output=]
+ * Spawns each count of pawns on the map, ticks their animation for a fixed number of frames
+ * and writes anim update / evaluate time percentiles and ground traces per frame as JSON.
+ */
+UCLASS()
+class UFootIKBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End of UCommandlet interface
+};
@@ -23,6 +23,7 @@ public class FootIKEditor : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[] {
 				"SlateCore",
+				"Json",
 			}
 		);
 	}
@@ -0,0 +1,40 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "FootIKEditorPrivatePCH.h"
+
+/////////////////////////////////////////////////////
+// UAnimGraphNode_MultiFootPlacementIK
+
+#define LOCTEXT_NAMESPACE "A3Nodes"
+
+UAnimGraphNode_MultiFootPlacementIK::UAnimGraphNode_MultiFootPlacementIK(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+FText UAnimGraphNode_MultiFootPlacementIK::GetControllerDescription() const
+{
+	return LOCTEXT("MultiFootPlacementIK", "Multi foot placement IK");
+}
+
+FText UAnimGraphNode_MultiFootPlacementIK::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("ControllerDescription"), GetControllerDescription());
+	Args.Add(TEXT("NumLimbs"), FText::AsNumber(Node.Limbs.Num()));
+
+	if(TitleType == ENodeTitleType::ListView || TitleType == ENodeTitleType::MenuTitle)
+	{
+		if (Node.Limbs.Num() == 0)
+		{
+			return FText::Format(LOCTEXT("MultiFootPlacementIK_MenuTitle", "{ControllerDescription}"), Args);
+		}
+		return FText::Format(LOCTEXT("MultiFootPlacementIK_ListTitle", "{ControllerDescription} - Limbs: {NumLimbs}"), Args);
+	}
+	else
+	{
+		return FText::Format(LOCTEXT("MultiFootPlacementIK_FullTitle", "{ControllerDescription}\nLimbs: {NumLimbs}"), Args);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,211 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "FootIKEditorPrivatePCH.h"
+#include "FootIKBenchmarkCommandlet.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFootIKBenchmark, Log, All);
+
+/** frames ticked before measuring, so blend-ins and caches settle */
+static const int32 NumWarmupFrames = 10;
+
+/** distance between spawned pawns */
+static const float PawnSpacing = 200.f;
+
+/** value below which Percentile of the samples fall, Samples have to be sorted */
+static double GetPercentile(const TArray<double>& SortedSamples, float Percentile)
+{
+	if (SortedSamples.Num() == 0)
+	{
+		return 0.0;
+	}
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+	return SortedSamples[Index];
+}
+
+/** p50/p90/p99/max of Samples as a json object */
+static TSharedRef<FJsonObject> MakePercentilesObject(TArray<double>& Samples)
+{
+	Samples.Sort();
+
+	TSharedRef<FJsonObject> Object = MakeShareable(new FJsonObject());
+	Object->SetNumberField(TEXT("p50"), GetPercentile(Samples, 0.5f));
+	Object->SetNumberField(TEXT("p90"), GetPercentile(Samples, 0.9f));
+	Object->SetNumberField(TEXT("p99"), GetPercentile(Samples, 0.99f));
+	Object->SetNumberField(TEXT("max"), GetPercentile(Samples, 1.f));
+	return Object;
+}
+
+UFootIKBenchmarkCommandlet::UFootIKBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UFootIKBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString MapName = TEXT("/Game/Maps/Platformer_StreetSection");
+	FString PawnName = TEXT("/Game/Pawn/PlayerPawn.PlayerPawn_C");
+	FString CountsParam = TEXT("1,10,100,500");
+	FString OutputPath = FPaths::GameSavedDir() / TEXT("FootIKBenchmark.json");
+	int32 NumFrames = 300;
+	float DeltaTime = 1.f / 60.f;
+
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	FParse::Value(*Params, TEXT("Pawn="), PawnName);
+	FParse::Value(*Params, TEXT("Counts="), CountsParam, false);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+
+	TArray<FString> Counts;
+	CountsParam.ParseIntoArray(Counts, TEXT(","), true);
+
+	UClass* PawnClass = LoadObject<UClass>(nullptr, *PawnName);
+	if (PawnClass == nullptr || !PawnClass->IsChildOf(ACharacter::StaticClass()))
+	{
+		UE_LOG(LogFootIKBenchmark, Error, TEXT("Pawn class %s not found or not a character"), *PawnName);
+		return 1;
+	}
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogFootIKBenchmark, Error, TEXT("Map %s not found"), *MapName);
+		return 1;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitWorld(UWorld::InitializationValues().AllowAudioPlayback(false).ShouldSimulatePhysics(false).EnableTraceCollision(true));
+
+	// street geometry lives in sublevels, all of it has to be there for traces to hit it
+	for (ULevelStreaming* StreamingLevel : World->StreamingLevels)
+	{
+		if (StreamingLevel)
+		{
+			StreamingLevel->bShouldBeLoaded = true;
+			StreamingLevel->bShouldBeVisible = true;
+		}
+	}
+	World->UpdateWorldComponents(true, false);
+	World->FlushLevelStreaming();
+
+	FVector Origin = FVector::ZeroVector;
+	FRotator OriginRotation = FRotator::ZeroRotator;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		OriginRotation = It->GetActorRotation();
+		break;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Runs;
+	for (const FString& CountString : Counts)
+	{
+		const int32 NumPawns = FCString::Atoi(*CountString);
+		if (NumPawns <= 0)
+		{
+			continue;
+		}
+
+		// pawns are laid out in a square grid around the player start
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt(NumPawns));
+
+		TArray<ACharacter*> Pawns;
+		TArray<USkeletalMeshComponent*> Meshes;
+		for (int32 PawnIndex = 0; PawnIndex < NumPawns; PawnIndex++)
+		{
+			const FVector Location = Origin + FVector((PawnIndex % NumColumns) * PawnSpacing, (PawnIndex / NumColumns) * PawnSpacing, 0.f);
+			ACharacter* Pawn = World->SpawnActor<ACharacter>(PawnClass, Location, OriginRotation, SpawnParams);
+			if (Pawn && Pawn->GetMesh())
+			{
+				Pawn->GetMesh()->MeshComponentUpdateFlag = EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
+				Pawns.Add(Pawn);
+				Meshes.Add(Pawn->GetMesh());
+			}
+		}
+
+		TArray<double> UpdateTimes;
+		TArray<double> EvaluateTimes;
+		TArray<double> TracesPerFrame;
+		for (int32 FrameIndex = 0; FrameIndex < NumWarmupFrames + NumFrames; FrameIndex++)
+		{
+			World->TimeSeconds += DeltaTime;
+			World->DeltaTimeSeconds = DeltaTime;
+
+			// async traces submitted last frame are resolved here, as they would be in a world tick
+			World->ResetAsyncTrace();
+
+			const uint32 NumTracesBefore = FootPlacementIK::NumGroundTraces;
+			const double StartTime = FPlatformTime::Seconds();
+			for (USkeletalMeshComponent* Mesh : Meshes)
+			{
+				Mesh->TickAnimation(DeltaTime, false);
+			}
+			const double UpdateEndTime = FPlatformTime::Seconds();
+			for (USkeletalMeshComponent* Mesh : Meshes)
+			{
+				Mesh->RefreshBoneTransforms();
+			}
+			const double EvaluateEndTime = FPlatformTime::Seconds();
+
+			World->FinishAsyncTrace();
+
+			if (FrameIndex >= NumWarmupFrames)
+			{
+				UpdateTimes.Add((UpdateEndTime - StartTime) * 1000.0);
+				EvaluateTimes.Add((EvaluateEndTime - UpdateEndTime) * 1000.0);
+				TracesPerFrame.Add(FootPlacementIK::NumGroundTraces - NumTracesBefore);
+			}
+		}
+
+		for (ACharacter* Pawn : Pawns)
+		{
+			World->DestroyActor(Pawn);
+		}
+
+		TSharedRef<FJsonObject> Run = MakeShareable(new FJsonObject());
+		Run->SetNumberField(TEXT("characters"), Meshes.Num());
+		Run->SetObjectField(TEXT("update_ms"), MakePercentilesObject(UpdateTimes));
+		Run->SetObjectField(TEXT("evaluate_ms"), MakePercentilesObject(EvaluateTimes));
+		Run->SetObjectField(TEXT("traces_per_frame"), MakePercentilesObject(TracesPerFrame));
+		Runs.Add(MakeShareable(new FJsonValueObject(Run)));
+
+		UE_LOG(LogFootIKBenchmark, Display, TEXT("%d characters: update p50 %.3f ms, evaluate p50 %.3f ms, %.0f traces per frame"),
+			Meshes.Num(), GetPercentile(UpdateTimes, 0.5f), GetPercentile(EvaluateTimes, 0.5f), GetPercentile(TracesPerFrame, 0.5f));
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShareable(new FJsonObject());
+	Result->SetStringField(TEXT("map"), MapName);
+	Result->SetStringField(TEXT("pawn"), PawnName);
+	Result->SetNumberField(TEXT("frames"), NumFrames);
+	Result->SetNumberField(TEXT("delta_time"), DeltaTime);
+	Result->SetArrayField(TEXT("runs"), Runs);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Result, Writer);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+	{
+		UE_LOG(LogFootIKBenchmark, Error, TEXT("Failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogFootIKBenchmark, Display, TEXT("Results written to %s"), *OutputPath);
+	return 0;
+}
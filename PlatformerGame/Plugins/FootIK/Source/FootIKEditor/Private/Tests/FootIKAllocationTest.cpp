@@ -0,0 +1,237 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "FootIKEditorPrivatePCH.h"
+#include "Animation/AnimBlueprintGeneratedClass.h"
+#include "Engine/StaticMeshActor.h"
+
+/** Forwards to the malloc it replaces, counting allocations made on the thread that installed it. */
+class FFootIKCountingMalloc : public FMalloc
+{
+public:
+	FFootIKCountingMalloc()
+		: InnerMalloc(nullptr)
+		, ThreadId(0)
+		, NumAllocations(0)
+	{
+	}
+
+	/** replaces GMalloc, allocations of the calling thread are counted from now on */
+	void Install()
+	{
+		check(InnerMalloc == nullptr);
+		InnerMalloc = GMalloc;
+		ThreadId = FPlatformTLS::GetCurrentThreadId();
+		GMalloc = this;
+	}
+
+	/** puts back the replaced malloc */
+	void Uninstall()
+	{
+		check(GMalloc == this);
+		GMalloc = InnerMalloc;
+		InnerMalloc = nullptr;
+	}
+
+	/** allocations counted so far */
+	int32 GetNumAllocations() const
+	{
+		return NumAllocations;
+	}
+
+	// FMalloc interface
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return InnerMalloc->Malloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return InnerMalloc->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		InnerMalloc->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return InnerMalloc->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return InnerMalloc->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return InnerMalloc->IsInternallyThreadSafe();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return TEXT("FootIKCountingMalloc");
+	}
+	// End of FMalloc interface
+
+private:
+	void CountAllocation()
+	{
+		if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+		{
+			NumAllocations++;
+		}
+	}
+
+	/** malloc everything is forwarded to */
+	FMalloc* InnerMalloc;
+
+	/** thread allocations are counted on */
+	uint32 ThreadId;
+
+	/** allocations made on ThreadId since construction */
+	int32 NumAllocations;
+};
+
+/** makes the node query ground every update through the async trace path, whatever the asset is set to */
+template <typename NodeType>
+static void ConfigureNodeForTest(NodeType* Node)
+{
+	Node->bUseAsyncTrace = true;
+	Node->GroundCacheDistance = 0.f;
+	Node->bUseMovementFloor = false;
+	Node->LOD.bSkipWhenNotRendered = false;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootIKAllocationTest, "FootIK.Allocations", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootIKAllocationTest::RunTest(const FString& Parameters)
+{
+	const TCHAR* PawnName = TEXT("/Game/Pawn/PlayerPawn.PlayerPawn_C");
+	const float DeltaTime = 1.f / 60.f;
+	const int32 NumWarmupFrames = 10;
+	const int32 NumFrames = 40;
+
+	UClass* PawnClass = LoadObject<UClass>(nullptr, PawnName);
+	UStaticMesh* FloorMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (PawnClass == nullptr || !PawnClass->IsChildOf(ACharacter::StaticClass()) || FloorMesh == nullptr)
+	{
+		AddError(FString::Printf(TEXT("Pawn class %s or floor mesh not found"), PawnName));
+		return false;
+	}
+
+	// anim graph is evaluated right here, so allocations of a worker thread don't go unnoticed
+	IConsoleVariable* ParallelEvaluationCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("a.ParallelAnimEvaluation"));
+	const int32 ParallelEvaluation = ParallelEvaluationCVar ? ParallelEvaluationCVar->GetInt() : 0;
+	if (ParallelEvaluationCVar)
+	{
+		ParallelEvaluationCVar->Set(0);
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// 100 unit cube scaled to a wide slab with its top at Z = 0
+	AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.f, 0.f, -50.f), FRotator::ZeroRotator);
+	Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(FloorMesh);
+	Floor->SetActorScale3D(FVector(100.f, 100.f, 1.f));
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ACharacter* Pawn = World->SpawnActor<ACharacter>(PawnClass, FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator, SpawnParams);
+	USkeletalMeshComponent* Mesh = Pawn ? Pawn->GetMesh() : nullptr;
+	UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+	UAnimBlueprintGeneratedClass* AnimClass = AnimInstance ? Cast<UAnimBlueprintGeneratedClass>(AnimInstance->GetClass()) : nullptr;
+
+	TArray<FAnimNode_SkeletalControlBase*> Nodes;
+	if (AnimClass)
+	{
+		for (UStructProperty* NodeProperty : AnimClass->AnimNodeProperties)
+		{
+			if (NodeProperty->Struct->IsChildOf(FAnimNode_MultiFootPlacementIK::StaticStruct()))
+			{
+				FAnimNode_MultiFootPlacementIK* Node = NodeProperty->ContainerPtrToValuePtr<FAnimNode_MultiFootPlacementIK>(AnimInstance);
+				ConfigureNodeForTest(Node);
+				Nodes.Add(Node);
+			}
+			else if (NodeProperty->Struct->IsChildOf(FAnimNode_FootPlacementIK::StaticStruct()))
+			{
+				FAnimNode_FootPlacementIK* Node = NodeProperty->ContainerPtrToValuePtr<FAnimNode_FootPlacementIK>(AnimInstance);
+				ConfigureNodeForTest(Node);
+				Nodes.Add(Node);
+			}
+		}
+	}
+
+	if (Nodes.Num() == 0)
+	{
+		AddError(FString::Printf(TEXT("%s has no foot placement nodes"), PawnName));
+	}
+	else
+	{
+		Mesh->MeshComponentUpdateFlag = EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
+
+		// bone references, blend alphas and async trace buffers are set up by regular updates first
+		for (int32 FrameIndex = 0; FrameIndex < NumWarmupFrames; FrameIndex++)
+		{
+			World->TimeSeconds += DeltaTime;
+			World->DeltaTimeSeconds = DeltaTime;
+			World->ResetAsyncTrace();
+			Mesh->TickAnimation(DeltaTime, false);
+			Mesh->RefreshBoneTransforms();
+			World->FinishAsyncTrace();
+		}
+
+		FCompactPose Pose;
+		Pose.SetBoneContainer(&AnimInstance->GetRequiredBones());
+		Pose.ResetToRefPose();
+		FCSPose<FCompactPose> MeshBases;
+		MeshBases.InitPose(Pose);
+
+		TArray<FBoneTransform> OutBoneTransforms;
+		OutBoneTransforms.Reserve(Pose.GetNumBones());
+
+		static FFootIKCountingMalloc CountingMalloc;
+		const int32 NumAllocationsBefore = CountingMalloc.GetNumAllocations();
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		{
+			// the pawn runs along X and is lifted off the floor every few frames, so traces alternate between hits and misses
+			const bool bAirborne = (FrameIndex / 5) % 2 == 1;
+			Pawn->SetActorLocation(FVector(FrameIndex * 10.f, 0.f, bAirborne ? 1000.f : 100.f));
+
+			World->TimeSeconds += DeltaTime;
+			World->DeltaTimeSeconds = DeltaTime;
+			World->ResetAsyncTrace();
+			OutBoneTransforms.Reset();
+
+			CountingMalloc.Install();
+			for (FAnimNode_SkeletalControlBase* Node : Nodes)
+			{
+				Node->PreUpdate(AnimInstance);
+				Node->EvaluateBoneTransforms(Mesh, MeshBases, OutBoneTransforms);
+			}
+			CountingMalloc.Uninstall();
+
+			World->FinishAsyncTrace();
+		}
+
+		TestEqual(TEXT("Allocations in PreUpdate and EvaluateBoneTransforms"), CountingMalloc.GetNumAllocations() - NumAllocationsBefore, 0);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (ParallelEvaluationCVar)
+	{
+		ParallelEvaluationCVar->Set(ParallelEvaluation);
+	}
+	return true;
+}
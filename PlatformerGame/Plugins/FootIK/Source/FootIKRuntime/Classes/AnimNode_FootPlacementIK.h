@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "FootPlacementIKTypes.h"
 #include "AnimNode_FootPlacementIK.generated.h"
 
 USTRUCT()
@@ -42,12 +43,27 @@ struct FOOTIKRUNTIME_API FAnimNode_FootPlacementIK : public FAnimNode_SkeletalCo
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
 	float BlendTime;
 
-	/** Internal use - activation time for node blending */
-	float ActivationTime;
+	/** if set, ground trace is done asynchronously: it is submitted this frame and its result is used on the next one, extrapolated by foot velocity */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	uint32 bUseAsyncTrace:1;
+
+	/** if above zero, last ground hit of foot is reused (moved along its plane) until the foot gets this far from it in XY or the hit actor moves */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK, meta=(ClampMin="0.0"))
+	float GroundCacheDistance;
+
+	/** if set, ground under the feet is taken from the floor the owning character's movement component stands on, feet are only traced outside the capsule's footprint or when there is no walkable floor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	uint32 bUseMovementFloor:1;
+
+	/** distance thresholds past which ground is queried less often, or not at all */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=LOD)
+	FFootPlacementIKLODSettings LOD;
 
 	FAnimNode_FootPlacementIK();
 
 	// FAnimNode_Base interface
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
 	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
 	// End of FAnimNode_Base interface
 
@@ -57,23 +73,31 @@ struct FOOTIKRUNTIME_API FAnimNode_FootPlacementIK : public FAnimNode_SkeletalCo
 	// End of FAnimNode_SkeletalControlBase interface
 
 private:
-	enum EMyBlendState
-	{
-		STATE_UNKNOWN = 0,
-		STATE_BLEND_IN = 1,
-		STATE_BLEND_OUT = 2
-	};
+	/** bone indices of the IK chain, resolved in InitializeBoneReferences */
+	FFootPlacementIKLimbChain LimbChain;
 
-	/** state of our node (init, blend-in, blend-out) */
-	EMyBlendState BlendState;
+	/** ground trace and blending state of the foot */
+	FFootPlacementIKFootState FootState;
 
-	/** effector location calculated dynamically */
-	FVector EffectorLocation;
+	/** trace params, reused between updates */
+	FFootPlacementIKQueryParams QueryParams;
+
+	/** floor of the owning character, read once per update if bUseMovementFloor is set */
+	FFootPlacementIKMovementFloor MovementFloor;
+
+	/** LOD level picked on last update */
+	FFootPlacementIKLODSettings::ELevel LODLevel;
+
+	/** world time read in PreUpdate, used to blend feet on the anim thread */
+	float GatheredWorldTime;
 
 	// FAnimNode_SkeletalControlBase interface
 	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
 	// End of FAnimNode_SkeletalControlBase interface
 
-	/** calculate current effector location and blend alpha */
-	void CalculateEffector(float DeltaTime, USkeletalMeshComponent* SkelComp, FCSPose<FCompactPose>& MeshBases);
+	/** game thread part of the update: picks LOD level and queries ground below the foot */
+	void GatherGround(USkeletalMeshComponent* SkelComp);
+
+	/** calculate current effector location and blend alpha from gathered ground, safe to run on worker threads */
+	void CalculateEffector(float DeltaTime);
 };
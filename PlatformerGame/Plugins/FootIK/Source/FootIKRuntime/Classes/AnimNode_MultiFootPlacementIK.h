@@ -0,0 +1,92 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "FootPlacementIKTypes.h"
+#include "AnimNode_MultiFootPlacementIK.generated.h"
+
+/**
+ * Foot placement IK for any number of legs in a single node.
+ * Component transform and trace params are set up once per update, all foot traces are issued back to back
+ * and all limbs are solved together by the batch two bone solver into a single OutBoneTransforms array.
+ */
+USTRUCT()
+struct FOOTIKRUNTIME_API FAnimNode_MultiFootPlacementIK : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** legs to place on the ground */
+	UPROPERTY(EditAnywhere, Category=IK)
+	TArray<FFootPlacementIKLimb> Limbs;
+
+	/** if set, node can stretch as much as possible, bone to catch effector location */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	uint32 bAllowStretching:1;
+
+	/** limits for bone stretching */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	FVector2D StretchLimits;
+
+	/** time to blend in/out influence of each foot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	float BlendTime;
+
+	/** if set, ground traces are done asynchronously: they are submitted this frame and their results are used on the next one, extrapolated by foot velocity */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	uint32 bUseAsyncTrace:1;
+
+	/** if above zero, last ground hit of each foot is reused (moved along its plane) until the foot gets this far from it in XY or the hit actor moves */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK, meta=(ClampMin="0.0"))
+	float GroundCacheDistance;
+
+	/** if set, ground under the feet is taken from the floor the owning character's movement component stands on, feet are only traced outside the capsule's footprint or when there is no walkable floor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=IK)
+	uint32 bUseMovementFloor:1;
+
+	/** distance thresholds past which ground is queried less often, or not at all */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=LOD)
+	FFootPlacementIKLODSettings LOD;
+
+	FAnimNode_MultiFootPlacementIK();
+
+	// FAnimNode_Base interface
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
+	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
+	// End of FAnimNode_Base interface
+
+	// FAnimNode_SkeletalControlBase interface
+	virtual void EvaluateBoneTransforms(USkeletalMeshComponent* SkelComp, FCSPose<FCompactPose>& MeshBases, TArray<FBoneTransform>& OutBoneTransforms) override;
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+private:
+	/** bone indices of each limb's IK chain, resolved in InitializeBoneReferences */
+	TArray<FFootPlacementIKLimbChain> LimbChains;
+
+	/** ground trace and blending state, one per limb */
+	TArray<FFootPlacementIKFootState> FootStates;
+
+	/** trace params shared by all limbs, reused between updates */
+	FFootPlacementIKQueryParams QueryParams;
+
+	/** floor of the owning character, read once per update if bUseMovementFloor is set */
+	FFootPlacementIKMovementFloor MovementFloor;
+
+	/** LOD level picked on last update */
+	FFootPlacementIKLODSettings::ELevel LODLevel;
+
+	/** world time read in PreUpdate, used to blend feet on the anim thread */
+	float GatheredWorldTime;
+
+	// FAnimNode_SkeletalControlBase interface
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+	/** game thread part of the update: picks LOD level and queries ground below every foot */
+	void GatherGround(USkeletalMeshComponent* SkelComp);
+
+	/** calculate effector locations and blend alphas of all limbs from gathered ground, safe to run on worker threads */
+	void CalculateEffectors(float DeltaTime);
+};
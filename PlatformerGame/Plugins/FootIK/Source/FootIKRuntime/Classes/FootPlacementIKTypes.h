@@ -0,0 +1,240 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "FootPlacementIKTypes.generated.h"
+
+namespace FootPlacementIK
+{
+	/** running total of ground traces issued by foot placement nodes, for tools measuring IK cost outside of the stats system; only touched on the game thread */
+	extern FOOTIKRUNTIME_API uint32 NumGroundTraces;
+}
+
+/** Single leg handled by FAnimNode_MultiFootPlacementIK. Foot bone's parent and grandparent are used as lower and upper limb. */
+USTRUCT()
+struct FOOTIKRUNTIME_API FFootPlacementIKLimb
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Name of foot bone to control. **/
+	UPROPERTY(EditAnywhere, Category=IK)
+	FBoneReference IKBone;
+
+	/** Joint target location, defines the plane the knee bends in. **/
+	UPROPERTY(EditAnywhere, Category=JointTarget)
+	FVector JointTargetLocation;
+
+	/** Reference frame of Joint Target Location. */
+	UPROPERTY(EditAnywhere, Category=JointTarget)
+	TEnumAsByte<enum EBoneControlSpace> JointTargetLocationSpace;
+
+	/** If JointTargetLocationSpace is a bone, this is the bone to use. **/
+	UPROPERTY(EditAnywhere, Category=JointTarget)
+	FName JointTargetSpaceBoneName;
+
+	/** Z offset from hit point, to correct effector location */
+	UPROPERTY(EditAnywhere, Category=IK)
+	float HitZOffset;
+
+	FFootPlacementIKLimb()
+		: JointTargetLocation(FVector::ZeroVector)
+		, JointTargetLocationSpace(BCS_ComponentSpace)
+		, HitZOffset(0.f)
+	{
+	}
+};
+
+/** Distance based level of detail of foot placement nodes, so only meshes close to the camera pay for full rate traces. */
+USTRUCT()
+struct FOOTIKRUNTIME_API FFootPlacementIKLODSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	enum ELevel
+	{
+		/** ground is queried every update */
+		LOD_Full = 0,
+		/** ground is queried once per ReducedUpdateInterval, feet follow the last ground plane in between */
+		LOD_Reduced = 1,
+		/** no ground queries, feet blend out */
+		LOD_Disabled = 2,
+		/** mesh was not rendered recently, node does no work at all */
+		LOD_Hidden = 3
+	};
+
+	/** if above zero, ground is queried at a reduced rate when the mesh is further than this from every view */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=LOD, meta=(ClampMin="0.0"))
+	float ReducedUpdateDistance;
+
+	/** seconds between ground queries past ReducedUpdateDistance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=LOD, meta=(ClampMin="0.0"))
+	float ReducedUpdateInterval;
+
+	/** if above zero, ground queries stop and feet blend out when the mesh is further than this from every view */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=LOD, meta=(ClampMin="0.0"))
+	float DisableDistance;
+
+	/** if set, node is skipped while the mesh is not being rendered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=LOD)
+	uint32 bSkipWhenNotRendered:1;
+
+	FFootPlacementIKLODSettings();
+
+	/** picks the level SkelComp should update at, from its distance to the views rendered last frame, but no better than footik.MinLODLevel */
+	ELevel GetLevel(const USkeletalMeshComponent* SkelComp) const;
+};
+
+/** Compact pose indices of a foot IK chain, resolved when required bones change instead of on every evaluate. */
+struct FOOTIKRUNTIME_API FFootPlacementIKLimbChain
+{
+	/** foot bone's grandparent */
+	FCompactPoseBoneIndex UpperLimbIndex;
+
+	/** foot bone's parent */
+	FCompactPoseBoneIndex LowerLimbIndex;
+
+	/** foot bone */
+	FCompactPoseBoneIndex EndBoneIndex;
+
+	/** bone the joint target is relative to, INDEX_NONE unless joint target space is a bone space */
+	FCompactPoseBoneIndex JointTargetSpaceBoneIndex;
+
+	/** if foot bone, lower limb and upper limb are all in required bones */
+	bool bValid;
+
+	FFootPlacementIKLimbChain();
+
+	/** resolves chain indices; call whenever required bones change */
+	void Initialize(const FBoneContainer& RequiredBones, const FBoneReference& FootBone, EBoneControlSpace JointTargetLocationSpace, const FName& JointTargetSpaceBoneName);
+};
+
+/** Runtime state of a single foot: pending ground trace and effector blending. */
+struct FOOTIKRUNTIME_API FFootPlacementIKFootState
+{
+	enum EBlendState
+	{
+		STATE_UNKNOWN = 0,
+		STATE_BLEND_IN = 1,
+		STATE_BLEND_OUT = 2
+	};
+
+	/** state of the foot (init, blend-in, blend-out) */
+	EBlendState BlendState;
+
+	/** activation time for foot blending */
+	float ActivationTime;
+
+	/** current blend alpha <0, 1> */
+	float Alpha;
+
+	/** effector location calculated dynamically, world space */
+	FVector EffectorLocation;
+
+	/** handle of the async ground trace submitted on previous update */
+	FTraceHandle PendingTraceHandle;
+
+	/** foot world location at the time PendingTraceHandle was submitted */
+	FVector PendingTraceFootLocation;
+
+	/** last blocking ground hit, reprojected instead of tracing while the foot stays close to where it was taken */
+	FHitResult GroundSample;
+
+	/** foot world location GroundSample was taken at */
+	FVector GroundSampleFootLocation;
+
+	/** transform of GroundSample's actor when it was taken, sample is dropped once the actor moves */
+	FTransform GroundSampleActorTransform;
+
+	/** if GroundSample holds a blocking hit */
+	bool bGroundSampleValid;
+
+	/** seconds since the scene was last queried for this foot, used to throttle queries at reduced LOD */
+	float GroundQueryAge;
+
+	/** ground below the foot, gathered on the game thread and consumed by UpdateEffector on the anim thread */
+	FHitResult GroundHit;
+
+	/** foot world location GroundHit was gathered for */
+	FVector GroundHitFootLocation;
+
+	/** component space location of the foot bone in reference pose */
+	FVector RefPoseFootLocation;
+
+	/** if RefPoseFootLocation was found for current required bones */
+	bool bRefPoseValid;
+
+	FFootPlacementIKFootState();
+
+	/** caches component space reference pose of the foot; call whenever required bones change */
+	void CacheRefPose(const FBoneContainer& RequiredBones, const FBoneReference& FootBone);
+
+	/**
+	 * Traces ground below the foot, either synchronously or by consuming last frame's async trace.
+	 * If GroundCacheDistance is above zero, the last ground hit is reprojected on its plane instead while the foot stays within that XY distance of it.
+	 */
+	void TraceGround(UWorld* World, const FCollisionQueryParams& QueryParams, const FVector& FootLocation, bool bAsync, float GroundCacheDistance, FHitResult& OutHit);
+
+	/** follows GroundSample's plane to FootLocation without querying the scene, OutHit is left empty if there is no sample */
+	void FollowGroundSample(const FVector& FootLocation, FHitResult& OutHit) const;
+
+	/** traces ground with TraceGround at LOD_Full, throttled by ReducedUpdateInterval at LOD_Reduced, and blends the foot out at LOD_Disabled */
+	void TraceGroundLOD(FFootPlacementIKLODSettings::ELevel LODLevel, const FFootPlacementIKLODSettings& LODSettings, UWorld* World, const FCollisionQueryParams& QueryParams, const FVector& FootLocation, bool bAsync, float GroundCacheDistance, float DeltaTime, FHitResult& OutHit);
+
+	/** updates blend state, Alpha and EffectorLocation from ground hit */
+	void UpdateEffector(const FHitResult& Hit, const FVector& FootLocation, float HitZOffset, bool bAllowStretching, float BlendTime, float DeltaTime, float WorldTime);
+
+private:
+	/** copies GroundSample to OutHit moved to FootLocation along the hit plane, returns false if the sample can't be used */
+	bool ReprojectGroundSample(const FVector& FootLocation, float GroundCacheDistance, FHitResult& OutHit) const;
+
+	/** stores Hit as GroundSample if it's a blocking hit, clears the sample otherwise */
+	void StoreGroundSample(const FHitResult& Hit, const FVector& FootLocation);
+};
+
+/** Collision query params for foot traces, rebuilt only when the owning actor changes. */
+struct FOOTIKRUNTIME_API FFootPlacementIKQueryParams
+{
+	FFootPlacementIKQueryParams();
+
+	/** returns params ignoring InOwner */
+	const FCollisionQueryParams& Get(const AActor* InOwner);
+
+private:
+	/** cached params */
+	FCollisionQueryParams Params;
+
+	/** actor Params were built for */
+	TWeakObjectPtr<const AActor> Owner;
+
+	/** if Params were built at least once */
+	bool bInitialized;
+};
+
+/** Floor the owning character's movement component found on its last move, used as ground under the feet instead of tracing. */
+struct FOOTIKRUNTIME_API FFootPlacementIKMovementFloor
+{
+	FFootPlacementIKMovementFloor();
+
+	/** reads floor of SkelComp's owning character, returns false if the character is not walking on a walkable floor */
+	bool Update(const USkeletalMeshComponent* SkelComp);
+
+	/**
+	 * Fills OutHit with the floor plane point below FootLocation.
+	 * Returns false if there is no usable floor or the foot is outside the capsule's footprint, the foot has to be traced then.
+	 */
+	bool GetGroundHit(const FVector& FootLocation, FHitResult& OutHit) const;
+
+private:
+	/** floor hit of the movement component's last floor check */
+	FHitResult FloorHit;
+
+	/** capsule center at the time of the floor check */
+	FVector CapsuleLocation;
+
+	/** squared capsule radius, feet further than that from its center in XY are not over FloorHit */
+	float CapsuleRadiusSquared;
+
+	/** if FloorHit can be used this update */
+	bool bValid;
+};
@@ -0,0 +1,200 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "FootIKRuntimePrivatePCH.h"
+#include "AnimationRuntime.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "FootPlacementIKSolver.h"
+#include "FootIKStats.h"
+
+FAnimNode_MultiFootPlacementIK::FAnimNode_MultiFootPlacementIK()
+	: FAnimNode_SkeletalControlBase()
+	, BlendTime(0.2f)
+	, bUseAsyncTrace(false)
+	, GroundCacheDistance(0.f)
+	, bUseMovementFloor(false)
+	, LODLevel(FFootPlacementIKLODSettings::LOD_Full)
+	, GatheredWorldTime(0.f)
+{
+}
+
+void FAnimNode_MultiFootPlacementIK::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	GatherGround(InAnimInstance->GetSkelMeshComponent());
+}
+
+void FAnimNode_MultiFootPlacementIK::UpdateInternal(const FAnimationUpdateContext& Context)
+{
+	FAnimNode_SkeletalControlBase::UpdateInternal(Context);
+
+	CalculateEffectors(Context.GetDeltaTime());
+}
+
+void FAnimNode_MultiFootPlacementIK::GatherGround(USkeletalMeshComponent* SkelComp)
+{
+	// foot states (and their cached reference pose) are set up in InitializeBoneReferences
+	if (FootStates.Num() != Limbs.Num())
+	{
+		return;
+	}
+
+	// hidden meshes keep their last effectors and skip evaluation, see IsValidToEvaluate
+	LODLevel = LOD.GetLevel(SkelComp);
+	if (LODLevel == FFootPlacementIKLODSettings::LOD_Hidden)
+	{
+		return;
+	}
+
+	// everything shared by the limbs is set up once
+	UWorld* World = SkelComp->GetWorld();
+	const FTransform& ComponentToWorld = SkelComp->ComponentToWorld;
+	const FCollisionQueryParams& LimbQueryParams = QueryParams.Get(SkelComp->GetOwner());
+	const float WorldDeltaTime = World->GetDeltaSeconds();
+	const bool bMovementFloorValid = bUseMovementFloor && LODLevel != FFootPlacementIKLODSettings::LOD_Disabled && MovementFloor.Update(SkelComp);
+	GatheredWorldTime = World->GetTimeSeconds();
+
+	for (FFootPlacementIKFootState& FootState : FootStates)
+	{
+		if (!FootState.bRefPoseValid)
+		{
+			continue;
+		}
+
+		const FVector EndBoneWorldPos = ComponentToWorld.TransformPosition(FootState.RefPoseFootLocation);
+		FootState.GroundHit = FHitResult();
+		FootState.GroundHitFootLocation = EndBoneWorldPos;
+
+		if (!bMovementFloorValid || !MovementFloor.GetGroundHit(EndBoneWorldPos, FootState.GroundHit))
+		{
+			FootState.TraceGroundLOD(LODLevel, LOD, World, LimbQueryParams, EndBoneWorldPos, bUseAsyncTrace, GroundCacheDistance, WorldDeltaTime, FootState.GroundHit);
+		}
+	}
+}
+
+void FAnimNode_MultiFootPlacementIK::CalculateEffectors(float DeltaTime)
+{
+	// ground was gathered in PreUpdate, nothing here touches the world so it is safe on worker threads
+	if (FootStates.Num() != Limbs.Num() || LODLevel == FFootPlacementIKLODSettings::LOD_Hidden)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FootIK_CalculateEffector);
+	for (int32 LimbIndex = 0; LimbIndex < Limbs.Num(); LimbIndex++)
+	{
+		FFootPlacementIKFootState& FootState = FootStates[LimbIndex];
+		if (FootState.bRefPoseValid)
+		{
+			FootState.UpdateEffector(FootState.GroundHit, FootState.GroundHitFootLocation, Limbs[LimbIndex].HitZOffset, bAllowStretching, BlendTime, DeltaTime, GatheredWorldTime);
+		}
+	}
+}
+
+void FAnimNode_MultiFootPlacementIK::EvaluateBoneTransforms(USkeletalMeshComponent* SkelComp, FCSPose<FCompactPose>& MeshBases, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	// limbs are gathered first and solved together, several per SIMD batch
+	TArray<FootPlacementIK::FLimbSolveTask, TInlineAllocator<8>> SolveTasks;
+	TArray<float, TInlineAllocator<8>> SolveTaskAlphas;
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FootIK_SpaceConversion);
+		const FTransform WorldToComponent = SkelComp->ComponentToWorld.Inverse();
+		for (int32 LimbIndex = 0; LimbIndex < Limbs.Num() && LimbIndex < LimbChains.Num(); LimbIndex++)
+		{
+			const FFootPlacementIKLimb& Limb = Limbs[LimbIndex];
+			const FFootPlacementIKLimbChain& LimbChain = LimbChains[LimbIndex];
+			const FFootPlacementIKFootState& FootState = FootStates[LimbIndex];
+			if (!LimbChain.bValid || FootState.Alpha <= ZERO_ANIMWEIGHT_THRESH)
+			{
+				continue;
+			}
+
+			const FVector EffectorCSPos = WorldToComponent.TransformPosition(FootState.EffectorLocation);
+
+			// Get joint target (used for defining plane that joint should be in).
+			FTransform JointTargetTransform(Limb.JointTargetLocation);
+			if (Limb.JointTargetLocationSpace != BCS_ComponentSpace)
+			{
+				FAnimationRuntime::ConvertBoneSpaceTransformToCS(SkelComp, MeshBases, JointTargetTransform, LimbChain.JointTargetSpaceBoneIndex, Limb.JointTargetLocationSpace);
+			}
+
+			SolveTasks.Add(FootPlacementIK::FLimbSolveTask(LimbChain.UpperLimbIndex, LimbChain.LowerLimbIndex, LimbChain.EndBoneIndex, EffectorCSPos, JointTargetTransform.GetTranslation()));
+			SolveTaskAlphas.Add(FootState.Alpha);
+		}
+	}
+
+	const int32 FirstLimbTransform = OutBoneTransforms.Num();
+	FootPlacementIK::SolveTwoBoneIKBatch(MeshBases, SolveTasks.GetData(), SolveTasks.Num(), bAllowStretching, StretchLimits, OutBoneTransforms);
+
+	// each foot blends in and out on its own, node alpha is applied on top of that
+	for (int32 TaskIndex = 0; TaskIndex < SolveTasks.Num(); TaskIndex++)
+	{
+		const float FootAlpha = SolveTaskAlphas[TaskIndex];
+		if (FootAlpha < 1.f - ZERO_ANIMWEIGHT_THRESH)
+		{
+			for (int32 TransformIndex = FirstLimbTransform + TaskIndex * 3; TransformIndex < FirstLimbTransform + TaskIndex * 3 + 3; TransformIndex++)
+			{
+				FBoneTransform& BoneTransform = OutBoneTransforms[TransformIndex];
+				BoneTransform.Transform.Blend(MeshBases.GetComponentSpaceTransform(BoneTransform.BoneIndex), BoneTransform.Transform, FootAlpha);
+			}
+		}
+	}
+
+	// bone transforms have to be sorted parent first, limbs may have been listed in any order
+	OutBoneTransforms.Sort([](const FBoneTransform& A, const FBoneTransform& B)
+	{
+		return A.BoneIndex < B.BoneIndex;
+	});
+}
+
+bool FAnimNode_MultiFootPlacementIK::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	if (LODLevel == FFootPlacementIKLODSettings::LOD_Hidden)
+	{
+		return false;
+	}
+
+	// at disabled LOD, nothing is left to solve once every foot fully blended out
+	if (LODLevel == FFootPlacementIKLODSettings::LOD_Disabled)
+	{
+		bool bAnyFootBlended = false;
+		for (const FFootPlacementIKFootState& FootState : FootStates)
+		{
+			bAnyFootBlended |= (FootState.Alpha > ZERO_ANIMWEIGHT_THRESH);
+		}
+		if (!bAnyFootBlended)
+		{
+			return false;
+		}
+	}
+
+	// valid if at least one limb can be solved
+	for (const FFootPlacementIKLimb& Limb : Limbs)
+	{
+		if (Limb.IKBone.IsValid(RequiredBones))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FAnimNode_MultiFootPlacementIK::InitializeBoneReferences(const FBoneContainer& RequiredBones) 
+{
+	for (FFootPlacementIKLimb& Limb : Limbs)
+	{
+		if (!Limb.IKBone.Initialize(RequiredBones))
+		{
+			UE_LOG(LogAnimation, Warning, TEXT("FAnimNode_MultiFootPlacementIK::InitializeBoneReferences BoneIndex for Bone (%s) is not found in the Asset (%s)"), 
+				*Limb.IKBone.BoneName.ToString(), *GetNameSafe(RequiredBones.GetAsset()));
+		}
+	}
+
+	LimbChains.SetNum(Limbs.Num());
+	FootStates.SetNum(Limbs.Num());
+	for (int32 LimbIndex = 0; LimbIndex < Limbs.Num(); LimbIndex++)
+	{
+		const FFootPlacementIKLimb& Limb = Limbs[LimbIndex];
+		LimbChains[LimbIndex].Initialize(RequiredBones, Limb.IKBone, Limb.JointTargetLocationSpace, Limb.JointTargetSpaceBoneName);
+		FootStates[LimbIndex].CacheRefPose(RequiredBones, Limb.IKBone);
+	}
+}
@@ -0,0 +1,418 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Engine independent analytic two bone IK solver working on SoA batches of limbs.
+ *
+ * Same solve as FAnimNode_FootPlacementIK used to do per limb with FVector math, written once as a kernel over "lanes"
+ * and instantiated for plain floats, SSE (4 limbs) and AVX (8 limbs). Every lane type runs the same sequence of
+ * IEEE operations (add, sub, mul, div, sqrt, compare, select), so scalar and SIMD results are bit identical as long
+ * as the compiler is not allowed to contract mul+add into FMA. Acos/Sin are not needed: sin(acos(c)) == sqrt(1 - c*c).
+ *
+ * Only depends on the C math library and compiler intrinsics, so it can be built and benchmarked outside of the engine.
+ */
+
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define FOOTIK_BATCH_SSE 1
+#else
+	#define FOOTIK_BATCH_SSE 0
+#endif
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define FOOTIK_BATCH_AVX 1
+#else
+	#define FOOTIK_BATCH_AVX 0
+#endif
+
+namespace FootIKBatch
+{
+	/** SoA input arrays, one entry per limb. All positions are in the same (component) space. */
+	struct FLimbInput
+	{
+		/** upper limb (root of the chain) position */
+		const float* RootX; const float* RootY; const float* RootZ;
+		/** lower limb (joint) position before solving */
+		const float* JointX; const float* JointY; const float* JointZ;
+		/** end bone position before solving */
+		const float* EndX; const float* EndY; const float* EndZ;
+		/** effector location to reach */
+		const float* TargetX; const float* TargetY; const float* TargetZ;
+		/** joint target, defines the plane the joint bends in */
+		const float* PoleX; const float* PoleY; const float* PoleZ;
+		/** length of upper and lower limb */
+		const float* UpperLength; const float* LowerLength;
+	};
+
+	/** SoA output arrays, one entry per limb. */
+	struct FLimbOutput
+	{
+		/** solved joint and end bone positions */
+		float* JointX; float* JointY; float* JointZ;
+		float* EndX; float* EndY; float* EndZ;
+		/** delta rotation (x, y, z, w) to apply to upper limb and lower limb rotations */
+		float* UpperRotX; float* UpperRotY; float* UpperRotZ; float* UpperRotW;
+		float* LowerRotX; float* LowerRotY; float* LowerRotZ; float* LowerRotW;
+	};
+
+	/** settings shared by all limbs of a batch */
+	struct FSolveSettings
+	{
+		/** if set, limbs can stretch to reach the target */
+		bool bAllowStretching;
+		/** reach ratio stretching starts at */
+		float StretchMin;
+		/** maximum stretch scale */
+		float StretchMax;
+
+		FSolveSettings()
+			: bAllowStretching(false)
+			, StretchMin(0.f)
+			, StretchMax(0.f)
+		{
+		}
+	};
+
+	/** single limb lanes */
+	struct FScalarLanes
+	{
+		typedef float FReal;
+		typedef bool FMask;
+		enum { Width = 1 };
+
+		static FReal Load(const float* Ptr) { return *Ptr; }
+		static void Store(float* Ptr, FReal A) { *Ptr = A; }
+		static FReal Set(float A) { return A; }
+		static FReal Add(FReal A, FReal B) { return A + B; }
+		static FReal Sub(FReal A, FReal B) { return A - B; }
+		static FReal Mul(FReal A, FReal B) { return A * B; }
+		static FReal Div(FReal A, FReal B) { return A / B; }
+		static FReal Sqrt(FReal A) { return sqrtf(A); }
+		static FReal Neg(FReal A) { return -A; }
+		static FReal Abs(FReal A) { return fabsf(A); }
+		static FMask Less(FReal A, FReal B) { return A < B; }
+		static FMask Greater(FReal A, FReal B) { return A > B; }
+		static FMask GreaterEq(FReal A, FReal B) { return A >= B; }
+		static FMask NotEqual(FReal A, FReal B) { return A != B; }
+		static FMask And(FMask A, FMask B) { return A && B; }
+		static FMask Or(FMask A, FMask B) { return A || B; }
+		static FReal Select(FMask Mask, FReal A, FReal B) { return Mask ? A : B; }
+	};
+
+#if FOOTIK_BATCH_SSE
+	/** 4 limbs per batch */
+	struct FSSELanes
+	{
+		typedef __m128 FReal;
+		typedef __m128 FMask;
+		enum { Width = 4 };
+
+		static FReal Load(const float* Ptr) { return _mm_loadu_ps(Ptr); }
+		static void Store(float* Ptr, FReal A) { _mm_storeu_ps(Ptr, A); }
+		static FReal Set(float A) { return _mm_set1_ps(A); }
+		static FReal Add(FReal A, FReal B) { return _mm_add_ps(A, B); }
+		static FReal Sub(FReal A, FReal B) { return _mm_sub_ps(A, B); }
+		static FReal Mul(FReal A, FReal B) { return _mm_mul_ps(A, B); }
+		static FReal Div(FReal A, FReal B) { return _mm_div_ps(A, B); }
+		static FReal Sqrt(FReal A) { return _mm_sqrt_ps(A); }
+		static FReal Neg(FReal A) { return _mm_xor_ps(A, _mm_set1_ps(-0.f)); }
+		static FReal Abs(FReal A) { return _mm_andnot_ps(_mm_set1_ps(-0.f), A); }
+		static FMask Less(FReal A, FReal B) { return _mm_cmplt_ps(A, B); }
+		static FMask Greater(FReal A, FReal B) { return _mm_cmpgt_ps(A, B); }
+		static FMask GreaterEq(FReal A, FReal B) { return _mm_cmpge_ps(A, B); }
+		static FMask NotEqual(FReal A, FReal B) { return _mm_cmpneq_ps(A, B); }
+		static FMask And(FMask A, FMask B) { return _mm_and_ps(A, B); }
+		static FMask Or(FMask A, FMask B) { return _mm_or_ps(A, B); }
+		static FReal Select(FMask Mask, FReal A, FReal B) { return _mm_or_ps(_mm_and_ps(Mask, A), _mm_andnot_ps(Mask, B)); }
+	};
+#endif
+
+#if FOOTIK_BATCH_AVX
+	/** 8 limbs per batch */
+	struct FAVXLanes
+	{
+		typedef __m256 FReal;
+		typedef __m256 FMask;
+		enum { Width = 8 };
+
+		static FReal Load(const float* Ptr) { return _mm256_loadu_ps(Ptr); }
+		static void Store(float* Ptr, FReal A) { _mm256_storeu_ps(Ptr, A); }
+		static FReal Set(float A) { return _mm256_set1_ps(A); }
+		static FReal Add(FReal A, FReal B) { return _mm256_add_ps(A, B); }
+		static FReal Sub(FReal A, FReal B) { return _mm256_sub_ps(A, B); }
+		static FReal Mul(FReal A, FReal B) { return _mm256_mul_ps(A, B); }
+		static FReal Div(FReal A, FReal B) { return _mm256_div_ps(A, B); }
+		static FReal Sqrt(FReal A) { return _mm256_sqrt_ps(A); }
+		static FReal Neg(FReal A) { return _mm256_xor_ps(A, _mm256_set1_ps(-0.f)); }
+		static FReal Abs(FReal A) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), A); }
+		static FMask Less(FReal A, FReal B) { return _mm256_cmp_ps(A, B, _CMP_LT_OQ); }
+		static FMask Greater(FReal A, FReal B) { return _mm256_cmp_ps(A, B, _CMP_GT_OQ); }
+		static FMask GreaterEq(FReal A, FReal B) { return _mm256_cmp_ps(A, B, _CMP_GE_OQ); }
+		static FMask NotEqual(FReal A, FReal B) { return _mm256_cmp_ps(A, B, _CMP_NEQ_UQ); }
+		static FMask And(FMask A, FMask B) { return _mm256_and_ps(A, B); }
+		static FMask Or(FMask A, FMask B) { return _mm256_or_ps(A, B); }
+		static FReal Select(FMask Mask, FReal A, FReal B) { return _mm256_blendv_ps(B, A, Mask); }
+	};
+#endif
+
+	/** 3D vector of lanes */
+	template<typename L>
+	struct TVec
+	{
+		typename L::FReal X, Y, Z;
+	};
+
+	template<typename L>
+	inline TVec<L> MakeVec(typename L::FReal X, typename L::FReal Y, typename L::FReal Z)
+	{
+		TVec<L> Result = { X, Y, Z };
+		return Result;
+	}
+
+	template<typename L>
+	inline TVec<L> LoadVec(const float* X, const float* Y, const float* Z, int Index)
+	{
+		return MakeVec<L>(L::Load(X + Index), L::Load(Y + Index), L::Load(Z + Index));
+	}
+
+	template<typename L>
+	inline void StoreVec(float* X, float* Y, float* Z, int Index, const TVec<L>& V)
+	{
+		L::Store(X + Index, V.X);
+		L::Store(Y + Index, V.Y);
+		L::Store(Z + Index, V.Z);
+	}
+
+	template<typename L>
+	inline TVec<L> AddVec(const TVec<L>& A, const TVec<L>& B)
+	{
+		return MakeVec<L>(L::Add(A.X, B.X), L::Add(A.Y, B.Y), L::Add(A.Z, B.Z));
+	}
+
+	template<typename L>
+	inline TVec<L> SubVec(const TVec<L>& A, const TVec<L>& B)
+	{
+		return MakeVec<L>(L::Sub(A.X, B.X), L::Sub(A.Y, B.Y), L::Sub(A.Z, B.Z));
+	}
+
+	template<typename L>
+	inline TVec<L> ScaleVec(const TVec<L>& A, typename L::FReal S)
+	{
+		return MakeVec<L>(L::Mul(A.X, S), L::Mul(A.Y, S), L::Mul(A.Z, S));
+	}
+
+	template<typename L>
+	inline typename L::FReal Dot(const TVec<L>& A, const TVec<L>& B)
+	{
+		return L::Add(L::Add(L::Mul(A.X, B.X), L::Mul(A.Y, B.Y)), L::Mul(A.Z, B.Z));
+	}
+
+	template<typename L>
+	inline TVec<L> Cross(const TVec<L>& A, const TVec<L>& B)
+	{
+		return MakeVec<L>(
+			L::Sub(L::Mul(A.Y, B.Z), L::Mul(A.Z, B.Y)),
+			L::Sub(L::Mul(A.Z, B.X), L::Mul(A.X, B.Z)),
+			L::Sub(L::Mul(A.X, B.Y), L::Mul(A.Y, B.X)));
+	}
+
+	template<typename L>
+	inline TVec<L> SelectVec(typename L::FMask Mask, const TVec<L>& A, const TVec<L>& B)
+	{
+		return MakeVec<L>(L::Select(Mask, A.X, B.X), L::Select(Mask, A.Y, B.Y), L::Select(Mask, A.Z, B.Z));
+	}
+
+	/** FVector::GetSafeNormal: zero vector when squared size is below SMALL_NUMBER */
+	template<typename L>
+	inline TVec<L> SafeNormal(const TVec<L>& A)
+	{
+		const typename L::FReal SquareSum = Dot<L>(A, A);
+		const typename L::FReal Scale = L::Div(L::Set(1.f), L::Sqrt(SquareSum));
+		const typename L::FReal Zero = L::Set(0.f);
+		return SelectVec<L>(L::Less(SquareSum, L::Set(1.e-8f)), MakeVec<L>(Zero, Zero, Zero), ScaleVec<L>(A, Scale));
+	}
+
+	/** FVector::Normalize: left untouched when squared size is not above SMALL_NUMBER */
+	template<typename L>
+	inline TVec<L> Normalize(const TVec<L>& A)
+	{
+		const typename L::FReal SquareSum = Dot<L>(A, A);
+		const typename L::FReal Scale = L::Div(L::Set(1.f), L::Sqrt(SquareSum));
+		return SelectVec<L>(L::Greater(SquareSum, L::Set(1.e-8f)), ScaleVec<L>(A, Scale), A);
+	}
+
+	/** FQuat::FindBetweenNormals, followed by FQuat::Normalize */
+	template<typename L>
+	inline void FindBetweenNormals(const TVec<L>& A, const TVec<L>& B, typename L::FReal& OutX, typename L::FReal& OutY, typename L::FReal& OutZ, typename L::FReal& OutW)
+	{
+		typedef typename L::FReal FReal;
+		typedef typename L::FMask FMask;
+
+		const FReal Zero = L::Set(0.f);
+		const FReal W = L::Add(L::Set(1.f), Dot<L>(A, B));
+		const FMask bNotOpposite = L::GreaterEq(W, L::Set(1.e-6f));
+		const TVec<L> Axis = Cross<L>(A, B);
+
+		// A and B point in opposite directions, rotate 180 degrees around any perpendicular axis
+		const FMask bXMajor = L::Greater(L::Abs(A.X), L::Abs(A.Y));
+		const FReal NegAZ = L::Neg(A.Z);
+		const FReal OppositeX = L::Select(bXMajor, NegAZ, Zero);
+		const FReal OppositeY = L::Select(bXMajor, Zero, NegAZ);
+		const FReal OppositeZ = L::Select(bXMajor, A.X, A.Y);
+
+		const FReal X = L::Select(bNotOpposite, Axis.X, OppositeX);
+		const FReal Y = L::Select(bNotOpposite, Axis.Y, OppositeY);
+		const FReal Z = L::Select(bNotOpposite, Axis.Z, OppositeZ);
+		const FReal QW = L::Select(bNotOpposite, W, Zero);
+
+		const FReal SquareSum = L::Add(L::Add(L::Add(L::Mul(X, X), L::Mul(Y, Y)), L::Mul(Z, Z)), L::Mul(QW, QW));
+		const FMask bCanNormalize = L::GreaterEq(SquareSum, L::Set(1.e-8f));
+		const FReal Scale = L::Div(L::Set(1.f), L::Sqrt(SquareSum));
+		OutX = L::Select(bCanNormalize, L::Mul(X, Scale), Zero);
+		OutY = L::Select(bCanNormalize, L::Mul(Y, Scale), Zero);
+		OutZ = L::Select(bCanNormalize, L::Mul(Z, Scale), Zero);
+		OutW = L::Select(bCanNormalize, L::Mul(QW, Scale), L::Set(1.f));
+	}
+
+	/** solves L::Width limbs starting at Index */
+	template<typename L>
+	inline void SolveLanes(const FLimbInput& In, const FLimbOutput& Out, const FSolveSettings& Settings, int Index)
+	{
+		typedef typename L::FReal FReal;
+		typedef typename L::FMask FMask;
+
+		const FReal Zero = L::Set(0.f);
+		const FReal One = L::Set(1.f);
+		const FReal KindaSmall = L::Set(1.e-4f);
+		const FReal KindaSmallSquared = L::Mul(KindaSmall, KindaSmall);
+
+		const TVec<L> RootPos = LoadVec<L>(In.RootX, In.RootY, In.RootZ, Index);
+		const TVec<L> InitialJointPos = LoadVec<L>(In.JointX, In.JointY, In.JointZ, Index);
+		const TVec<L> InitialEndPos = LoadVec<L>(In.EndX, In.EndY, In.EndZ, Index);
+		const TVec<L> DesiredPos = LoadVec<L>(In.TargetX, In.TargetY, In.TargetZ, Index);
+		const TVec<L> JointTargetPos = LoadVec<L>(In.PoleX, In.PoleY, In.PoleZ, Index);
+		FReal UpperLimbLength = L::Load(In.UpperLength + Index);
+		FReal LowerLimbLength = L::Load(In.LowerLength + Index);
+
+		// Direction to the reach goal, handling the case where DesiredPos is the same as RootPos.
+		const TVec<L> DesiredDelta = SubVec<L>(DesiredPos, RootPos);
+		FReal DesiredLength = L::Sqrt(Dot<L>(DesiredDelta, DesiredDelta));
+		const FMask bDesiredAtRoot = L::Less(DesiredLength, KindaSmall);
+		const TVec<L> DesiredDir = SelectVec<L>(bDesiredAtRoot, MakeVec<L>(One, Zero, Zero),
+			MakeVec<L>(L::Div(DesiredDelta.X, DesiredLength), L::Div(DesiredDelta.Y, DesiredLength), L::Div(DesiredDelta.Z, DesiredLength)));
+		DesiredLength = L::Select(bDesiredAtRoot, KindaSmall, DesiredLength);
+
+		// Direction the joint bends in.
+		const TVec<L> JointTargetDelta = SubVec<L>(JointTargetPos, RootPos);
+		const FMask bJointTargetAtRoot = L::Less(Dot<L>(JointTargetDelta, JointTargetDelta), KindaSmallSquared);
+		const TVec<L> JointPlaneNormal = Cross<L>(DesiredDir, JointTargetDelta);
+		const FMask bJointTargetOnLine = L::Less(Dot<L>(JointPlaneNormal, JointPlaneNormal), KindaSmallSquared);
+
+		// FVector::FindBestAxisVectors, used when joint target is on the root -> effector line
+		const FMask bZMajor = L::And(L::Greater(L::Abs(DesiredDir.Z), L::Abs(DesiredDir.X)), L::Greater(L::Abs(DesiredDir.Z), L::Abs(DesiredDir.Y)));
+		TVec<L> Axis1 = MakeVec<L>(L::Select(bZMajor, One, Zero), Zero, L::Select(bZMajor, Zero, One));
+		Axis1 = SafeNormal<L>(SubVec<L>(Axis1, ScaleVec<L>(DesiredDir, Dot<L>(Axis1, DesiredDir))));
+		const TVec<L> Axis2 = Cross<L>(Axis1, DesiredDir);
+
+		// Remove any component of JointTargetDelta along DesiredDir.
+		const TVec<L> ProjectedBendDir = Normalize<L>(SubVec<L>(JointTargetDelta, ScaleVec<L>(DesiredDir, Dot<L>(JointTargetDelta, DesiredDir))));
+
+		const TVec<L> JointBendDir = SelectVec<L>(bJointTargetAtRoot, MakeVec<L>(Zero, One, Zero), SelectVec<L>(bJointTargetOnLine, Axis2, ProjectedBendDir));
+
+		FReal MaxLimbLength = L::Add(LowerLimbLength, UpperLimbLength);
+
+		const float ScaleRange = Settings.StretchMax - Settings.StretchMin;
+		if (Settings.bAllowStretching && ScaleRange > 1.e-4f)
+		{
+			const FReal ReachRatio = L::Div(DesiredLength, MaxLimbLength);
+			const FReal Range = L::Div(L::Sub(ReachRatio, L::Set(Settings.StretchMin)), L::Set(ScaleRange));
+			const FReal ClampedRange = L::Select(L::Less(Range, Zero), Zero, L::Select(L::Less(Range, One), Range, One));
+			const FReal ScalingFactor = L::Mul(L::Set(Settings.StretchMax - 1.f), ClampedRange);
+			const FMask bStretch = L::And(L::Greater(MaxLimbLength, KindaSmall), L::Greater(ScalingFactor, KindaSmall));
+			const FReal AdjustedFactor = L::Select(bStretch, L::Add(One, ScalingFactor), One);
+
+			LowerLimbLength = L::Mul(LowerLimbLength, AdjustedFactor);
+			UpperLimbLength = L::Mul(UpperLimbLength, AdjustedFactor);
+			MaxLimbLength = L::Mul(MaxLimbLength, AdjustedFactor);
+		}
+
+		// Goal beyond the length of the limb: extend limb fully towards it.
+		const FMask bOutOfReach = L::Greater(DesiredLength, MaxLimbLength);
+		const TVec<L> ExtendedEndPos = AddVec<L>(RootPos, ScaleVec<L>(DesiredDir, MaxLimbLength));
+		const TVec<L> ExtendedJointPos = AddVec<L>(RootPos, ScaleVec<L>(DesiredDir, UpperLimbLength));
+
+		// Law of cosines for the angle between DesiredDir and the upper limb.
+		const FReal TwoAB = L::Mul(L::Mul(L::Set(2.f), UpperLimbLength), DesiredLength);
+		const FReal CosNumerator = L::Sub(L::Add(L::Mul(UpperLimbLength, UpperLimbLength), L::Mul(DesiredLength, DesiredLength)), L::Mul(LowerLimbLength, LowerLimbLength));
+		const FReal CosAngle = L::Select(L::NotEqual(TwoAB, Zero), L::Div(CosNumerator, TwoAB), Zero);
+
+		// Triangle could not be made: limbs double back on themselves, going back by the smaller section.
+		const FMask bNoTriangle = L::Or(L::Greater(CosAngle, One), L::Less(CosAngle, L::Set(-1.f)));
+		const FMask bUpperLonger = L::Greater(UpperLimbLength, LowerLimbLength);
+		const TVec<L> UpperAlongDir = ScaleVec<L>(DesiredDir, UpperLimbLength);
+		const TVec<L> LowerAlongDir = ScaleVec<L>(DesiredDir, LowerLimbLength);
+		const TVec<L> FoldedJointPos = SelectVec<L>(bUpperLonger, AddVec<L>(RootPos, UpperAlongDir), SubVec<L>(RootPos, UpperAlongDir));
+		const TVec<L> FoldedEndPos = SelectVec<L>(bUpperLonger, SubVec<L>(FoldedJointPos, LowerAlongDir), AddVec<L>(FoldedJointPos, LowerAlongDir));
+
+		// Distance of the joint from the root -> effector line, and along it (negative when upper limb points away from DesiredDir).
+		const FReal SinSquared = L::Sub(One, L::Mul(CosAngle, CosAngle));
+		const FReal JointLineDist = L::Mul(UpperLimbLength, L::Sqrt(L::Select(L::Greater(SinSquared, Zero), SinSquared, Zero)));
+		const FReal ProjJointDist = L::Mul(UpperLimbLength, CosAngle);
+		const TVec<L> TriangleJointPos = AddVec<L>(AddVec<L>(RootPos, ScaleVec<L>(DesiredDir, ProjJointDist)), ScaleVec<L>(JointBendDir, JointLineDist));
+
+		const TVec<L> OutJointPos = SelectVec<L>(bOutOfReach, ExtendedJointPos, SelectVec<L>(bNoTriangle, FoldedJointPos, TriangleJointPos));
+		const TVec<L> OutEndPos = SelectVec<L>(bOutOfReach, ExtendedEndPos, SelectVec<L>(bNoTriangle, FoldedEndPos, DesiredPos));
+
+		StoreVec<L>(Out.JointX, Out.JointY, Out.JointZ, Index, OutJointPos);
+		StoreVec<L>(Out.EndX, Out.EndY, Out.EndZ, Index, OutEndPos);
+
+		// Delta rotations taking old limb directions to new ones.
+		FReal QX, QY, QZ, QW;
+		FindBetweenNormals<L>(SafeNormal<L>(SubVec<L>(InitialJointPos, RootPos)), SafeNormal<L>(SubVec<L>(OutJointPos, RootPos)), QX, QY, QZ, QW);
+		L::Store(Out.UpperRotX + Index, QX);
+		L::Store(Out.UpperRotY + Index, QY);
+		L::Store(Out.UpperRotZ + Index, QZ);
+		L::Store(Out.UpperRotW + Index, QW);
+
+		FindBetweenNormals<L>(SafeNormal<L>(SubVec<L>(InitialEndPos, InitialJointPos)), SafeNormal<L>(SubVec<L>(OutEndPos, OutJointPos)), QX, QY, QZ, QW);
+		L::Store(Out.LowerRotX + Index, QX);
+		L::Store(Out.LowerRotY + Index, QY);
+		L::Store(Out.LowerRotZ + Index, QZ);
+		L::Store(Out.LowerRotW + Index, QW);
+	}
+
+	/** solves NumLimbs limbs one at a time, without SIMD */
+	inline void SolveScalar(const FLimbInput& In, const FLimbOutput& Out, const FSolveSettings& Settings, int NumLimbs)
+	{
+		for (int Index = 0; Index < NumLimbs; ++Index)
+		{
+			SolveLanes<FScalarLanes>(In, Out, Settings, Index);
+		}
+	}
+
+	/** solves NumLimbs limbs, 8 at a time with AVX and 4 at a time with SSE when available; remainder goes through the scalar path */
+	inline void Solve(const FLimbInput& In, const FLimbOutput& Out, const FSolveSettings& Settings, int NumLimbs)
+	{
+		int Index = 0;
+#if FOOTIK_BATCH_AVX
+		for (; Index + FAVXLanes::Width <= NumLimbs; Index += FAVXLanes::Width)
+		{
+			SolveLanes<FAVXLanes>(In, Out, Settings, Index);
+		}
+#endif
+#if FOOTIK_BATCH_SSE
+		for (; Index + FSSELanes::Width <= NumLimbs; Index += FSSELanes::Width)
+		{
+			SolveLanes<FSSELanes>(In, Out, Settings, Index);
+		}
+#endif
+		for (; Index < NumLimbs; ++Index)
+		{
+			SolveLanes<FScalarLanes>(In, Out, Settings, Index);
+		}
+	}
+}
@@ -1,6 +1,18 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "FootIKRuntimePrivatePCH.h"
+#include "FootIKStats.h"
+
+DEFINE_STAT(STAT_FootIK_GroundQuery);
+DEFINE_STAT(STAT_FootIK_CalculateEffector);
+DEFINE_STAT(STAT_FootIK_SpaceConversion);
+DEFINE_STAT(STAT_FootIK_TwoBoneSolve);
+
+DEFINE_STAT(STAT_FootIK_Traces);
+DEFINE_STAT(STAT_FootIK_GroundCacheHits);
+DEFINE_STAT(STAT_FootIK_MovementFloorHits);
+DEFINE_STAT(STAT_FootIK_BlendStateChanges);
+DEFINE_STAT(STAT_FootIK_LimbsSolved);
 
 
 IMPLEMENT_MODULE(FDefaultGameModuleImpl, FootIKRuntime);
@@ -0,0 +1,17 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** Foot IK stats, shown with "stat FootIK" and captured by "stat startfile" */
+DECLARE_STATS_GROUP(TEXT("FootIK"), STATGROUP_FootIK, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ground Query"), STAT_FootIK_GroundQuery, STATGROUP_FootIK, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Calculate Effector"), STAT_FootIK_CalculateEffector, STATGROUP_FootIK, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Space Conversion"), STAT_FootIK_SpaceConversion, STATGROUP_FootIK, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Two Bone Solve"), STAT_FootIK_TwoBoneSolve, STATGROUP_FootIK, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_FootIK_Traces, STATGROUP_FootIK, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Cache Hits"), STAT_FootIK_GroundCacheHits, STATGROUP_FootIK, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement Floor Hits"), STAT_FootIK_MovementFloorHits, STATGROUP_FootIK, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blend State Changes"), STAT_FootIK_BlendStateChanges, STATGROUP_FootIK, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Limbs Solved"), STAT_FootIK_LimbsSolved, STATGROUP_FootIK, );
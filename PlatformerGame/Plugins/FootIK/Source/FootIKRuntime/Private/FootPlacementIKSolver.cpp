@@ -0,0 +1,116 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "FootIKRuntimePrivatePCH.h"
+#include "FootPlacementIKSolver.h"
+#include "FootIKBatchSolver.h"
+#include "FootIKStats.h"
+
+namespace FootPlacementIK
+{
+	/** number of SoA float arrays needed per limb: 17 inputs, 14 outputs */
+	static const int32 NumBatchArrays = 31;
+
+	static void SolveTasks(FCSPose<FCompactPose>& MeshBases, const FLimbSolveTask* Tasks, int32 NumTasks, bool bAllowStretching, const FVector2D& StretchLimits, float* Storage, TArray<FBoneTransform>& OutBoneTransforms)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FootIK_TwoBoneSolve);
+		INC_DWORD_STAT_BY(STAT_FootIK_LimbsSolved, NumTasks);
+
+		float* Arrays[NumBatchArrays];
+		for (int32 ArrayIndex = 0; ArrayIndex < NumBatchArrays; ArrayIndex++)
+		{
+			Arrays[ArrayIndex] = Storage + ArrayIndex * NumTasks;
+		}
+
+		const FootIKBatch::FLimbInput In = {
+			Arrays[0], Arrays[1], Arrays[2],
+			Arrays[3], Arrays[4], Arrays[5],
+			Arrays[6], Arrays[7], Arrays[8],
+			Arrays[9], Arrays[10], Arrays[11],
+			Arrays[12], Arrays[13], Arrays[14],
+			Arrays[15], Arrays[16] };
+
+		const FootIKBatch::FLimbOutput Out = {
+			Arrays[17], Arrays[18], Arrays[19],
+			Arrays[20], Arrays[21], Arrays[22],
+			Arrays[23], Arrays[24], Arrays[25], Arrays[26],
+			Arrays[27], Arrays[28], Arrays[29], Arrays[30] };
+
+		for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
+		{
+			const FLimbSolveTask& Task = Tasks[TaskIndex];
+
+			// Get Local Space transforms for our bones. We do this first in case they already are local.
+			// As right after we get them in component space. (And that does the auto conversion).
+			// Use actual sizes instead of ref skeleton, so we take into account translation and scaling from other bone controllers.
+			Arrays[15][TaskIndex] = MeshBases.GetLocalSpaceTransform(Task.LowerLimbIndex).GetTranslation().Size();
+			Arrays[16][TaskIndex] = MeshBases.GetLocalSpaceTransform(Task.EndBoneIndex).GetTranslation().Size();
+
+			// All positions are in Component space.
+			const FVector RootPos = MeshBases.GetComponentSpaceTransform(Task.UpperLimbIndex).GetTranslation();
+			const FVector InitialJointPos = MeshBases.GetComponentSpaceTransform(Task.LowerLimbIndex).GetTranslation();
+			const FVector InitialEndPos = MeshBases.GetComponentSpaceTransform(Task.EndBoneIndex).GetTranslation();
+
+			const FVector* Positions[] = { &RootPos, &InitialJointPos, &InitialEndPos, &Task.DesiredPos, &Task.JointTargetPos };
+			for (int32 PositionIndex = 0; PositionIndex < ARRAY_COUNT(Positions); PositionIndex++)
+			{
+				Arrays[PositionIndex * 3 + 0][TaskIndex] = Positions[PositionIndex]->X;
+				Arrays[PositionIndex * 3 + 1][TaskIndex] = Positions[PositionIndex]->Y;
+				Arrays[PositionIndex * 3 + 2][TaskIndex] = Positions[PositionIndex]->Z;
+			}
+		}
+
+		FootIKBatch::FSolveSettings Settings;
+		Settings.bAllowStretching = bAllowStretching;
+		Settings.StretchMin = StretchLimits.X;
+		Settings.StretchMax = StretchLimits.Y;
+		FootIKBatch::Solve(In, Out, Settings, NumTasks);
+
+		OutBoneTransforms.Reserve(OutBoneTransforms.Num() + NumTasks * 3);
+		for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
+		{
+			const FLimbSolveTask& Task = Tasks[TaskIndex];
+			const FVector OutJointPos(Out.JointX[TaskIndex], Out.JointY[TaskIndex], Out.JointZ[TaskIndex]);
+			const FVector OutEndPos(Out.EndX[TaskIndex], Out.EndY[TaskIndex], Out.EndZ[TaskIndex]);
+
+			// Rotate upper limb by the delta rotation from old to new joint direction, order important: first bone is upper limb.
+			FTransform UpperLimbCSTransform = MeshBases.GetComponentSpaceTransform(Task.UpperLimbIndex);
+			const FQuat UpperDeltaRotation(Out.UpperRotX[TaskIndex], Out.UpperRotY[TaskIndex], Out.UpperRotZ[TaskIndex], Out.UpperRotW[TaskIndex]);
+			UpperLimbCSTransform.SetRotation(UpperDeltaRotation * UpperLimbCSTransform.GetRotation());
+			OutBoneTransforms.Add(FBoneTransform(Task.UpperLimbIndex, UpperLimbCSTransform));
+
+			// Second bone is lower limb, put where the joint should be.
+			FTransform LowerLimbCSTransform = MeshBases.GetComponentSpaceTransform(Task.LowerLimbIndex);
+			const FQuat LowerDeltaRotation(Out.LowerRotX[TaskIndex], Out.LowerRotY[TaskIndex], Out.LowerRotZ[TaskIndex], Out.LowerRotW[TaskIndex]);
+			LowerLimbCSTransform.SetRotation(LowerDeltaRotation * LowerLimbCSTransform.GetRotation());
+			LowerLimbCSTransform.SetTranslation(OutJointPos);
+			OutBoneTransforms.Add(FBoneTransform(Task.LowerLimbIndex, LowerLimbCSTransform));
+
+			// Third bone is End Bone.
+			FTransform EndBoneCSTransform = MeshBases.GetComponentSpaceTransform(Task.EndBoneIndex);
+			EndBoneCSTransform.SetTranslation(OutEndPos);
+			OutBoneTransforms.Add(FBoneTransform(Task.EndBoneIndex, EndBoneCSTransform));
+		}
+	}
+}
+
+void FootPlacementIK::SolveTwoBoneIKBatch(FCSPose<FCompactPose>& MeshBases, const FLimbSolveTask* Tasks, int32 NumTasks, bool bAllowStretching, const FVector2D& StretchLimits, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	if (NumTasks <= 0)
+	{
+		return;
+	}
+
+	FMemMark Mark(FMemStack::Get());
+	TArray<float, TMemStackAllocator<>> Storage;
+	Storage.AddUninitialized(NumTasks * NumBatchArrays);
+	SolveTasks(MeshBases, Tasks, NumTasks, bAllowStretching, StretchLimits, Storage.GetData(), OutBoneTransforms);
+}
+
+void FootPlacementIK::SolveTwoBoneIK(FCSPose<FCompactPose>& MeshBases, const FCompactPoseBoneIndex& UpperLimbIndex, const FCompactPoseBoneIndex& LowerLimbIndex, const FCompactPoseBoneIndex& EndBoneIndex,
+	const FVector& DesiredPos, const FVector& JointTargetPos, bool bAllowStretching, const FVector2D& StretchLimits, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	// single limb goes through the scalar lanes of the batch solver
+	const FLimbSolveTask Task(UpperLimbIndex, LowerLimbIndex, EndBoneIndex, DesiredPos, JointTargetPos);
+	float Storage[NumBatchArrays];
+	SolveTasks(MeshBases, &Task, 1, bAllowStretching, StretchLimits, Storage, OutBoneTransforms);
+}
@@ -0,0 +1,39 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+namespace FootPlacementIK
+{
+	/** UpperLimb -> LowerLimb -> EndBone chain to solve, positions in component space */
+	struct FLimbSolveTask
+	{
+		FCompactPoseBoneIndex UpperLimbIndex;
+		FCompactPoseBoneIndex LowerLimbIndex;
+		FCompactPoseBoneIndex EndBoneIndex;
+		FVector DesiredPos;
+		FVector JointTargetPos;
+
+		FLimbSolveTask(const FCompactPoseBoneIndex& InUpperLimbIndex, const FCompactPoseBoneIndex& InLowerLimbIndex, const FCompactPoseBoneIndex& InEndBoneIndex, const FVector& InDesiredPos, const FVector& InJointTargetPos)
+			: UpperLimbIndex(InUpperLimbIndex)
+			, LowerLimbIndex(InLowerLimbIndex)
+			, EndBoneIndex(InEndBoneIndex)
+			, DesiredPos(InDesiredPos)
+			, JointTargetPos(InJointTargetPos)
+		{
+		}
+	};
+
+	/**
+	 * Analytic two bone solve of all tasks at once, reaching for DesiredPos and bending towards JointTargetPos.
+	 * Limbs are gathered into SoA arrays and solved 4 or 8 at a time by FootIKBatch.
+	 * Appends upper limb, lower limb and end bone transforms (in that order) of every task to OutBoneTransforms, in task order.
+	 */
+	void SolveTwoBoneIKBatch(FCSPose<FCompactPose>& MeshBases, const FLimbSolveTask* Tasks, int32 NumTasks, bool bAllowStretching, const FVector2D& StretchLimits, TArray<FBoneTransform>& OutBoneTransforms);
+
+	/**
+	 * Analytic two bone solve of UpperLimb -> LowerLimb -> EndBone chain, reaching for DesiredPos and bending towards JointTargetPos.
+	 * All positions are in component space. Appends upper limb, lower limb and end bone transforms (in that order) to OutBoneTransforms.
+	 */
+	void SolveTwoBoneIK(FCSPose<FCompactPose>& MeshBases, const FCompactPoseBoneIndex& UpperLimbIndex, const FCompactPoseBoneIndex& LowerLimbIndex, const FCompactPoseBoneIndex& EndBoneIndex,
+		const FVector& DesiredPos, const FVector& JointTargetPos, bool bAllowStretching, const FVector2D& StretchLimits, TArray<FBoneTransform>& OutBoneTransforms);
+}
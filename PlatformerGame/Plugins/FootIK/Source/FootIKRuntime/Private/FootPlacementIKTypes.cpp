@@ -0,0 +1,393 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "FootIKRuntimePrivatePCH.h"
+#include "FootPlacementIKTypes.h"
+#include "FootIKStats.h"
+
+uint32 FootPlacementIK::NumGroundTraces = 0;
+
+static TAutoConsoleVariable<int32> CVarFootIKMinLODLevel(
+	TEXT("footik.MinLODLevel"),
+	0,
+	TEXT("Lowest detail every foot placement node runs at, whatever its distance to the view.\n")
+	TEXT(" 0: full rate ground queries\n")
+	TEXT(" 1: ground queried once per ReducedUpdateInterval, saves game thread time"),
+	ECVF_Scalability);
+
+FFootPlacementIKLODSettings::FFootPlacementIKLODSettings()
+	: ReducedUpdateDistance(0.f)
+	, ReducedUpdateInterval(0.1f)
+	, DisableDistance(0.f)
+	, bSkipWhenNotRendered(false)
+{
+}
+
+FFootPlacementIKLODSettings::ELevel FFootPlacementIKLODSettings::GetLevel(const USkeletalMeshComponent* SkelComp) const
+{
+	if (bSkipWhenNotRendered && !SkelComp->bRecentlyRendered)
+	{
+		return LOD_Hidden;
+	}
+
+	// feet are never blended out by the console variable, only by distance
+	const ELevel MinLevel = (ELevel)FMath::Clamp(CVarFootIKMinLODLevel.GetValueOnGameThread(), (int32)LOD_Full, (int32)LOD_Reduced);
+
+	const UWorld* World = SkelComp->GetWorld();
+	if ((ReducedUpdateDistance <= 0.f && DisableDistance <= 0.f) || World == nullptr || World->ViewLocationsRenderedLastFrame.Num() == 0)
+	{
+		return MinLevel;
+	}
+
+	float MinDistanceSquared = MAX_flt;
+	for (const FVector& ViewLocation : World->ViewLocationsRenderedLastFrame)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(ViewLocation, SkelComp->Bounds.Origin));
+	}
+
+	if (DisableDistance > 0.f && MinDistanceSquared > FMath::Square(DisableDistance))
+	{
+		return LOD_Disabled;
+	}
+	if (ReducedUpdateDistance > 0.f && MinDistanceSquared > FMath::Square(ReducedUpdateDistance))
+	{
+		return LOD_Reduced;
+	}
+	return MinLevel;
+}
+
+FFootPlacementIKLimbChain::FFootPlacementIKLimbChain()
+	: UpperLimbIndex(INDEX_NONE)
+	, LowerLimbIndex(INDEX_NONE)
+	, EndBoneIndex(INDEX_NONE)
+	, JointTargetSpaceBoneIndex(INDEX_NONE)
+	, bValid(false)
+{
+}
+
+void FFootPlacementIKLimbChain::Initialize(const FBoneContainer& RequiredBones, const FBoneReference& FootBone, EBoneControlSpace JointTargetLocationSpace, const FName& JointTargetSpaceBoneName)
+{
+	EndBoneIndex = FootBone.GetCompactPoseIndex(RequiredBones);
+	LowerLimbIndex = (EndBoneIndex != INDEX_NONE) ? RequiredBones.GetParentBoneIndex(EndBoneIndex) : FCompactPoseBoneIndex(INDEX_NONE);
+	UpperLimbIndex = (LowerLimbIndex != INDEX_NONE) ? RequiredBones.GetParentBoneIndex(LowerLimbIndex) : FCompactPoseBoneIndex(INDEX_NONE);
+
+	// If we walked past the root, this limb is invalid.
+	bValid = (UpperLimbIndex != INDEX_NONE);
+
+	const int32 JointTargetSpaceBoneIndexInt = (JointTargetLocationSpace == BCS_ParentBoneSpace || JointTargetLocationSpace == BCS_BoneSpace) ? RequiredBones.GetPoseBoneIndexForBoneName(JointTargetSpaceBoneName) : INDEX_NONE;
+	JointTargetSpaceBoneIndex = RequiredBones.MakeCompactPoseIndex(FMeshPoseBoneIndex(JointTargetSpaceBoneIndexInt));
+}
+
+FFootPlacementIKFootState::FFootPlacementIKFootState()
+	: BlendState(STATE_UNKNOWN)
+	, ActivationTime(0.f)
+	, Alpha(0.f)
+	, EffectorLocation(FVector::ZeroVector)
+	, PendingTraceFootLocation(FVector::ZeroVector)
+	, GroundSampleFootLocation(FVector::ZeroVector)
+	, bGroundSampleValid(false)
+	, GroundQueryAge(0.f)
+	, GroundHitFootLocation(FVector::ZeroVector)
+	, RefPoseFootLocation(FVector::ZeroVector)
+	, bRefPoseValid(false)
+{
+}
+
+void FFootPlacementIKFootState::CacheRefPose(const FBoneContainer& RequiredBones, const FBoneReference& FootBone)
+{
+	bRefPoseValid = false;
+
+	const FCompactPoseBoneIndex FootIndex = FootBone.GetCompactPoseIndex(RequiredBones);
+	if (FootIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// walk up to the root, accumulating local reference transforms
+	FTransform ComponentSpaceTransform = RequiredBones.GetRefPoseTransform(FootIndex);
+	for (FCompactPoseBoneIndex ParentIndex = RequiredBones.GetParentBoneIndex(FootIndex); ParentIndex != INDEX_NONE; ParentIndex = RequiredBones.GetParentBoneIndex(ParentIndex))
+	{
+		ComponentSpaceTransform *= RequiredBones.GetRefPoseTransform(ParentIndex);
+	}
+
+	RefPoseFootLocation = ComponentSpaceTransform.GetTranslation();
+	bRefPoseValid = true;
+}
+
+/** moves hit location by FootDelta in XY, keeping it on the hit plane (Z follows the surface slope along the XY displacement) */
+static void MoveAlongHitPlane(FHitResult& Hit, const FVector& FootDelta)
+{
+	const FVector& Normal = Hit.ImpactNormal;
+	const float SlopeZ = (Normal.Z > KINDA_SMALL_NUMBER) ? -(Normal.X * FootDelta.X + Normal.Y * FootDelta.Y) / Normal.Z : 0.f;
+	Hit.Location += FVector(FootDelta.X, FootDelta.Y, SlopeZ);
+}
+
+/**
+ * Returns results of an async trace submitted last frame, null if they aren't available.
+ * Same lookup as UWorld::QueryTraceData, but the results are read where they are instead of copied:
+ * copying FTraceDatum reallocates OutHits whenever the number of hits changes, e.g. every time a foot misses the ground.
+ */
+static const FTraceDatum* FindTraceData(UWorld* World, const FTraceHandle& Handle)
+{
+	if (!World->IsTraceHandleValid(Handle, false))
+	{
+		return nullptr;
+	}
+
+	AsyncTraceData& DataBuffer = World->AsyncTraceState.GetBufferForFrame(Handle._Data.FrameNumber);
+	const int32 BlockIndex = Handle._Data.Index / ASYNC_TRACE_BUFFER_SIZE;
+	const int32 DatumIndex = Handle._Data.Index % ASYNC_TRACE_BUFFER_SIZE;
+	if (!DataBuffer.TraceData.IsValidIndex(BlockIndex) || !DataBuffer.TraceData[BlockIndex].IsValid())
+	{
+		return nullptr;
+	}
+	return &DataBuffer.TraceData[BlockIndex]->Buffer[DatumIndex];
+}
+
+void FFootPlacementIKFootState::TraceGround(UWorld* World, const FCollisionQueryParams& QueryParams, const FVector& FootLocation, bool bAsync, float GroundCacheDistance, FHitResult& OutHit)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FootIK_GroundQuery);
+
+	const FVector TraceOffset(0,0,50);
+
+	// foot is still close to the last ground sample, no need to query the scene
+	if (GroundCacheDistance > 0.f && ReprojectGroundSample(FootLocation, GroundCacheDistance, OutHit))
+	{
+		INC_DWORD_STAT(STAT_FootIK_GroundCacheHits);
+		// drop any pending async trace, its result would be older than the sample by the time it's needed again
+		PendingTraceHandle = FTraceHandle();
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_FootIK_Traces);
+	FootPlacementIK::NumGroundTraces++;
+	if (!bAsync)
+	{
+		World->LineTraceSingleByChannel(OutHit, FootLocation + TraceOffset, FootLocation - TraceOffset, ECC_Pawn, QueryParams);
+		StoreGroundSample(OutHit, FootLocation);
+		return;
+	}
+
+	// results of the trace submitted last frame are available until the end of this one
+	const FTraceDatum* TraceData = PendingTraceHandle.IsValid() ? FindTraceData(World, PendingTraceHandle) : nullptr;
+	if (TraceData)
+	{
+		for (const FHitResult& TraceHit : TraceData->OutHits)
+		{
+			if (TraceHit.bBlockingHit)
+			{
+				OutHit = TraceHit;
+				break;
+			}
+		}
+
+		if (OutHit.Actor.IsValid())
+		{
+			// hit was found below last frame's foot location, so move it by foot velocity * frame time
+			MoveAlongHitPlane(OutHit, FootLocation - PendingTraceFootLocation);
+		}
+
+		StoreGroundSample(OutHit, FootLocation);
+	}
+	else if (GroundCacheDistance > 0.f && bGroundSampleValid)
+	{
+		// cached sample ran out and there is no trace in flight yet, keep following its plane for this one frame
+		OutHit = GroundSample;
+		MoveAlongHitPlane(OutHit, FootLocation - GroundSampleFootLocation);
+	}
+
+	// queue trace for the next update
+	PendingTraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, FootLocation + TraceOffset, FootLocation - TraceOffset, ECC_Pawn, QueryParams);
+	PendingTraceFootLocation = FootLocation;
+}
+
+void FFootPlacementIKFootState::FollowGroundSample(const FVector& FootLocation, FHitResult& OutHit) const
+{
+	if (bGroundSampleValid)
+	{
+		OutHit = GroundSample;
+		MoveAlongHitPlane(OutHit, FootLocation - GroundSampleFootLocation);
+	}
+}
+
+void FFootPlacementIKFootState::TraceGroundLOD(FFootPlacementIKLODSettings::ELevel LODLevel, const FFootPlacementIKLODSettings& LODSettings, UWorld* World, const FCollisionQueryParams& QueryParams, const FVector& FootLocation, bool bAsync, float GroundCacheDistance, float DeltaTime, FHitResult& OutHit)
+{
+	GroundQueryAge += DeltaTime;
+
+	if (LODLevel == FFootPlacementIKLODSettings::LOD_Disabled)
+	{
+		// leaving OutHit empty blends the foot out, and nothing in flight will be needed
+		PendingTraceHandle = FTraceHandle();
+		bGroundSampleValid = false;
+		return;
+	}
+
+	if (LODLevel == FFootPlacementIKLODSettings::LOD_Reduced && GroundQueryAge < LODSettings.ReducedUpdateInterval)
+	{
+		INC_DWORD_STAT(STAT_FootIK_GroundCacheHits);
+		FollowGroundSample(FootLocation, OutHit);
+		return;
+	}
+
+	TraceGround(World, QueryParams, FootLocation, bAsync, GroundCacheDistance, OutHit);
+}
+
+bool FFootPlacementIKFootState::ReprojectGroundSample(const FVector& FootLocation, float GroundCacheDistance, FHitResult& OutHit) const
+{
+	if (!bGroundSampleValid)
+	{
+		return false;
+	}
+
+	const FVector FootDelta = FootLocation - GroundSampleFootLocation;
+	if (FootDelta.SizeSquared2D() > FMath::Square(GroundCacheDistance))
+	{
+		return false;
+	}
+
+	// ground under the sample may have moved (platforms, physics objects) or been destroyed
+	const AActor* SampleActor = GroundSample.Actor.Get();
+	if (SampleActor == nullptr || !SampleActor->GetActorTransform().Equals(GroundSampleActorTransform, KINDA_SMALL_NUMBER))
+	{
+		return false;
+	}
+
+	OutHit = GroundSample;
+	MoveAlongHitPlane(OutHit, FootDelta);
+	return true;
+}
+
+void FFootPlacementIKFootState::StoreGroundSample(const FHitResult& Hit, const FVector& FootLocation)
+{
+	GroundQueryAge = 0.f;
+
+	const AActor* HitActor = Hit.Actor.Get();
+	bGroundSampleValid = (HitActor != nullptr);
+	if (bGroundSampleValid)
+	{
+		GroundSample = Hit;
+		GroundSampleFootLocation = FootLocation;
+		GroundSampleActorTransform = HitActor->GetActorTransform();
+	}
+}
+
+void FFootPlacementIKFootState::UpdateEffector(const FHitResult& Hit, const FVector& FootLocation, float HitZOffset, bool bAllowStretching, float BlendTime, float DeltaTime, float WorldTime)
+{
+	FVector DesiredEffectorLocation = FootLocation;
+
+	// check if we should blend-in or blend-out this foot
+	const EBlendState OldBlendState = BlendState;
+	if (Hit.Actor.IsValid())
+	{
+		DesiredEffectorLocation = Hit.Location + FVector(0,0,HitZOffset);
+		BlendState = STATE_BLEND_IN; 
+		if ((DesiredEffectorLocation - FootLocation).GetSafeNormal().Z <= 0 && !bAllowStretching)
+		{
+			BlendState = STATE_BLEND_OUT;
+		}
+	}
+	else
+	{
+		DesiredEffectorLocation = FootLocation;
+		BlendState = STATE_BLEND_OUT;
+	}
+
+	if (OldBlendState != BlendState)
+	{
+		INC_DWORD_STAT(STAT_FootIK_BlendStateChanges);
+		ActivationTime = WorldTime;
+	}
+
+	if (BlendState == STATE_BLEND_IN)
+	{
+		Alpha = ((WorldTime - ActivationTime) / BlendTime);
+	}
+	else if (BlendState == STATE_BLEND_OUT)
+	{
+		Alpha = 1-((WorldTime - ActivationTime) / BlendTime);
+	}
+
+	// base on foot state, calculate effector location (or keep current location)
+	if ((BlendState == STATE_BLEND_IN) && (Alpha >= 0.9f))
+	{
+		// we are almost fully blended in so blend effector location to new position (to avoid rapid effector location changes)
+		const float Delta = FMath::Clamp<float>(DeltaTime / BlendTime, 0.0f, 1.0f);
+		EffectorLocation = FVector(DesiredEffectorLocation.X, DesiredEffectorLocation.Y, EffectorLocation.Z + Delta * (DesiredEffectorLocation.Z - EffectorLocation.Z) );
+	}
+	else if (BlendState != STATE_BLEND_OUT)
+	{
+		EffectorLocation = DesiredEffectorLocation;
+	}
+	else if (EffectorLocation == FVector::ZeroVector)
+	{
+		EffectorLocation = FootLocation;
+	}
+
+	Alpha = FMath::Clamp<float>(Alpha, 0.0f, 1.0f);
+}
+
+FFootPlacementIKQueryParams::FFootPlacementIKQueryParams()
+	: bInitialized(false)
+{
+}
+
+const FCollisionQueryParams& FFootPlacementIKQueryParams::Get(const AActor* InOwner)
+{
+	if (!bInitialized || Owner.Get() != InOwner)
+	{
+		Params = FCollisionQueryParams(NAME_None, true, InOwner);
+		Owner = InOwner;
+		bInitialized = true;
+	}
+	return Params;
+}
+
+FFootPlacementIKMovementFloor::FFootPlacementIKMovementFloor()
+	: CapsuleLocation(FVector::ZeroVector)
+	, CapsuleRadiusSquared(0.f)
+	, bValid(false)
+{
+}
+
+bool FFootPlacementIKMovementFloor::Update(const USkeletalMeshComponent* SkelComp)
+{
+	bValid = false;
+
+	const ACharacter* Character = Cast<const ACharacter>(SkelComp->GetOwner());
+	const UCharacterMovementComponent* MovementComp = Character ? Character->GetCharacterMovement() : nullptr;
+	if (MovementComp == nullptr || !MovementComp->IsMovingOnGround())
+	{
+		return false;
+	}
+
+	const FFindFloorResult& CurrentFloor = MovementComp->CurrentFloor;
+	if (!CurrentFloor.IsWalkableFloor() || !CurrentFloor.HitResult.Actor.IsValid() || CurrentFloor.HitResult.ImpactNormal.Z <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	FloorHit = CurrentFloor.HitResult;
+	CapsuleLocation = Character->GetActorLocation();
+	CapsuleRadiusSquared = FMath::Square(Character->GetCapsuleComponent()->GetScaledCapsuleRadius());
+	bValid = true;
+	return true;
+}
+
+bool FFootPlacementIKMovementFloor::GetGroundHit(const FVector& FootLocation, FHitResult& OutHit) const
+{
+	if (!bValid || FVector::DistSquaredXY(FootLocation, CapsuleLocation) > CapsuleRadiusSquared)
+	{
+		return false;
+	}
+
+	// point on the floor plane straight below the foot
+	const FVector& Normal = FloorHit.ImpactNormal;
+	const FVector& PlanePoint = FloorHit.ImpactPoint;
+	const float PlaneZ = PlanePoint.Z - (Normal.X * (FootLocation.X - PlanePoint.X) + Normal.Y * (FootLocation.Y - PlanePoint.Y)) / Normal.Z;
+
+	INC_DWORD_STAT(STAT_FootIK_MovementFloorHits);
+
+	OutHit = FloorHit;
+	OutHit.Location = FVector(FootLocation.X, FootLocation.Y, PlaneZ);
+	OutHit.ImpactPoint = OutHit.Location;
+	return true;
+}
@@ -0,0 +1,493 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/**
+ * Standalone test and benchmark of FootIKBatchSolver.h, built without the engine (see Makefile).
+ *
+ * - every lane type available to the compiler must give bit identical results to the scalar lanes
+ * - results must match the per limb solver FAnimNode_FootPlacementIK used before the batch solver, within tolerance
+ * - prints ns per limb for the old solver and every lane type
+ *
+ * Returns non zero if a check failed.
+ */
+
+#include "FootIKBatchSolver.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+	/** limbs solved per run, not a multiple of 8 so the scalar remainder of Solve is covered too */
+	const int NumLimbs = 4099;
+
+	/** solves timed per lane type */
+	const int NumBenchmarkRuns = 200;
+
+	/** max position difference from the old solver computed in double, in the same units as the limb lengths (about 35-60) */
+	const float PositionTolerance = 1.e-3f;
+
+	/** max quaternion component difference from the old solver computed in double */
+	const float RotationTolerance = 1.e-4f;
+
+	/** owns SoA arrays of one batch */
+	struct FBatch
+	{
+		/** 17 input and 14 output arrays */
+		std::vector<float> Arrays[31];
+		FootIKBatch::FLimbInput In;
+		FootIKBatch::FLimbOutput Out;
+
+		explicit FBatch(int Num)
+		{
+			for (std::vector<float>& Array : Arrays)
+			{
+				Array.assign(Num, 0.f);
+			}
+			float* A[31];
+			for (int Index = 0; Index < 31; Index++)
+			{
+				A[Index] = Arrays[Index].data();
+			}
+			const FootIKBatch::FLimbInput InitIn = {
+				A[0], A[1], A[2], A[3], A[4], A[5], A[6], A[7], A[8],
+				A[9], A[10], A[11], A[12], A[13], A[14], A[15], A[16] };
+			const FootIKBatch::FLimbOutput InitOut = {
+				A[17], A[18], A[19], A[20], A[21], A[22],
+				A[23], A[24], A[25], A[26], A[27], A[28], A[29], A[30] };
+			In = InitIn;
+			Out = InitOut;
+		}
+
+		/** copies input arrays of Other, which has to have the same number of limbs */
+		void CopyInput(const FBatch& Other)
+		{
+			for (int Index = 0; Index < 17; Index++)
+			{
+				memcpy(Arrays[Index].data(), Other.Arrays[Index].data(), Arrays[Index].size() * sizeof(float));
+			}
+		}
+
+		/** writes output arrays with a pattern that can't be a result, so limbs left unsolved are noticed */
+		void PoisonOutput()
+		{
+			for (int Index = 17; Index < 31; Index++)
+			{
+				Arrays[Index].assign(Arrays[Index].size(), -12345.f);
+			}
+		}
+	};
+
+	/** vector math of the old per limb solver, same operations as FVector; T is float as in the engine, or double for reference results */
+	template<typename T>
+	struct TVec3
+	{
+		T X, Y, Z;
+
+		TVec3(T InX, T InY, T InZ) : X(InX), Y(InY), Z(InZ) {}
+		TVec3 operator+(const TVec3& V) const { return TVec3(X + V.X, Y + V.Y, Z + V.Z); }
+		TVec3 operator-(const TVec3& V) const { return TVec3(X - V.X, Y - V.Y, Z - V.Z); }
+		TVec3 operator*(T S) const { return TVec3(X * S, Y * S, Z * S); }
+		TVec3 operator/(T S) const { return TVec3(X / S, Y / S, Z / S); }
+		T operator|(const TVec3& V) const { return X * V.X + Y * V.Y + Z * V.Z; }
+		TVec3 operator^(const TVec3& V) const { return TVec3(Y * V.Z - Z * V.Y, Z * V.X - X * V.Z, X * V.Y - Y * V.X); }
+		T SizeSquared() const { return X * X + Y * Y + Z * Z; }
+		T Size() const { return sqrt(SizeSquared()); }
+
+		TVec3 GetSafeNormal() const
+		{
+			const T SquareSum = SizeSquared();
+			if (SquareSum < (T)1.e-8f)
+			{
+				return TVec3(0, 0, 0);
+			}
+			return *this * (1 / sqrt(SquareSum));
+		}
+
+		void Normalize()
+		{
+			const T SquareSum = SizeSquared();
+			if (SquareSum > (T)1.e-8f)
+			{
+				*this = *this * (1 / sqrt(SquareSum));
+			}
+		}
+
+		void FindBestAxisVectors(TVec3& Axis1, TVec3& Axis2) const
+		{
+			const T NX = fabs(X), NY = fabs(Y), NZ = fabs(Z);
+			Axis1 = (NZ > NX && NZ > NY) ? TVec3(1, 0, 0) : TVec3(0, 0, 1);
+			Axis1 = (Axis1 - *this * (Axis1 | *this)).GetSafeNormal();
+			Axis2 = Axis1 ^ *this;
+		}
+	};
+
+	/** FQuat::FindBetweenNormals followed by FQuat::Normalize */
+	template<typename T>
+	void FindBetweenNormals(const TVec3<T>& A, const TVec3<T>& B, T* OutQuat)
+	{
+		T W = 1 + (A | B);
+		T Q[4];
+		if (W >= (T)1.e-6f)
+		{
+			const TVec3<T> Axis = A ^ B;
+			Q[0] = Axis.X; Q[1] = Axis.Y; Q[2] = Axis.Z; Q[3] = W;
+		}
+		else
+		{
+			W = 0;
+			if (fabs(A.X) > fabs(A.Y))
+			{
+				Q[0] = -A.Z; Q[1] = 0; Q[2] = A.X; Q[3] = W;
+			}
+			else
+			{
+				Q[0] = 0; Q[1] = -A.Z; Q[2] = A.Y; Q[3] = W;
+			}
+		}
+
+		const T SquareSum = Q[0] * Q[0] + Q[1] * Q[1] + Q[2] * Q[2] + Q[3] * Q[3];
+		if (SquareSum >= (T)1.e-8f)
+		{
+			const T Scale = 1 / sqrt(SquareSum);
+			for (int Index = 0; Index < 4; Index++)
+			{
+				OutQuat[Index] = Q[Index] * Scale;
+			}
+		}
+		else
+		{
+			OutQuat[0] = OutQuat[1] = OutQuat[2] = 0;
+			OutQuat[3] = 1;
+		}
+	}
+
+	/** FootPlacementIK::SolveTwoBoneIK before the batch solver: branches and acos/sin instead of selects and sqrt */
+	template<typename T>
+	void SolveOldPerLimb(const FootIKBatch::FLimbInput& In, const FootIKBatch::FLimbOutput& Out, const FootIKBatch::FSolveSettings& Settings, int Index)
+	{
+		const T KindaSmall = 1.e-4f;
+		const TVec3<T> RootPos(In.RootX[Index], In.RootY[Index], In.RootZ[Index]);
+		const TVec3<T> InitialJointPos(In.JointX[Index], In.JointY[Index], In.JointZ[Index]);
+		const TVec3<T> InitialEndPos(In.EndX[Index], In.EndY[Index], In.EndZ[Index]);
+		const TVec3<T> DesiredPos(In.TargetX[Index], In.TargetY[Index], In.TargetZ[Index]);
+		const TVec3<T> JointTargetPos(In.PoleX[Index], In.PoleY[Index], In.PoleZ[Index]);
+
+		const TVec3<T> DesiredDelta = DesiredPos - RootPos;
+		T DesiredLength = DesiredDelta.Size();
+		TVec3<T> DesiredDir(1, 0, 0);
+		if (DesiredLength < KindaSmall)
+		{
+			DesiredLength = KindaSmall;
+		}
+		else
+		{
+			DesiredDir = DesiredDelta / DesiredLength;
+		}
+
+		const TVec3<T> JointTargetDelta = JointTargetPos - RootPos;
+		TVec3<T> JointPlaneNormal(0, 0, 1);
+		TVec3<T> JointBendDir(0, 1, 0);
+		if (JointTargetDelta.SizeSquared() >= KindaSmall * KindaSmall)
+		{
+			JointPlaneNormal = DesiredDir ^ JointTargetDelta;
+			if (JointPlaneNormal.SizeSquared() < KindaSmall * KindaSmall)
+			{
+				DesiredDir.FindBestAxisVectors(JointPlaneNormal, JointBendDir);
+			}
+			else
+			{
+				JointBendDir = JointTargetDelta - (DesiredDir * (JointTargetDelta | DesiredDir));
+				JointBendDir.Normalize();
+			}
+		}
+
+		T UpperLimbLength = In.UpperLength[Index];
+		T LowerLimbLength = In.LowerLength[Index];
+		T MaxLimbLength = LowerLimbLength + UpperLimbLength;
+
+		if (Settings.bAllowStretching)
+		{
+			const T ScaleRange = Settings.StretchMax - Settings.StretchMin;
+			if (ScaleRange > KindaSmall && MaxLimbLength > KindaSmall)
+			{
+				const T ReachRatio = DesiredLength / MaxLimbLength;
+				T Range = (ReachRatio - Settings.StretchMin) / ScaleRange;
+				Range = Range < 0.f ? 0.f : (Range < 1.f ? Range : 1.f);
+				const T ScalingFactor = (Settings.StretchMax - 1.f) * Range;
+				if (ScalingFactor > KindaSmall)
+				{
+					const T AdjustedFactor = 1.f + ScalingFactor;
+					LowerLimbLength *= AdjustedFactor;
+					UpperLimbLength *= AdjustedFactor;
+					MaxLimbLength *= AdjustedFactor;
+				}
+			}
+		}
+
+		TVec3<T> OutEndPos = DesiredPos;
+		TVec3<T> OutJointPos = InitialJointPos;
+		if (DesiredLength > MaxLimbLength)
+		{
+			OutEndPos = RootPos + DesiredDir * MaxLimbLength;
+			OutJointPos = RootPos + DesiredDir * UpperLimbLength;
+		}
+		else
+		{
+			const T TwoAB = 2.f * UpperLimbLength * DesiredLength;
+			const T CosAngle = (TwoAB != 0.f) ? ((UpperLimbLength * UpperLimbLength) + (DesiredLength * DesiredLength) - (LowerLimbLength * LowerLimbLength)) / TwoAB : 0.f;
+			const bool bReverseUpperBone = (CosAngle < 0.f);
+			if ((CosAngle > 1.f) || (CosAngle < -1.f))
+			{
+				if (UpperLimbLength > LowerLimbLength)
+				{
+					OutJointPos = RootPos + DesiredDir * UpperLimbLength;
+					OutEndPos = OutJointPos - DesiredDir * LowerLimbLength;
+				}
+				else
+				{
+					OutJointPos = RootPos - DesiredDir * UpperLimbLength;
+					OutEndPos = OutJointPos + DesiredDir * LowerLimbLength;
+				}
+			}
+			else
+			{
+				const T Angle = acos(CosAngle);
+				const T JointLineDist = UpperLimbLength * sin(Angle);
+				const T ProjJointDistSqr = (UpperLimbLength * UpperLimbLength) - (JointLineDist * JointLineDist);
+				T ProjJointDist = (ProjJointDistSqr > 0.f) ? sqrt(ProjJointDistSqr) : 0.f;
+				if (bReverseUpperBone)
+				{
+					ProjJointDist *= -1.f;
+				}
+				OutJointPos = RootPos + DesiredDir * ProjJointDist + JointBendDir * JointLineDist;
+			}
+		}
+
+		Out.JointX[Index] = OutJointPos.X; Out.JointY[Index] = OutJointPos.Y; Out.JointZ[Index] = OutJointPos.Z;
+		Out.EndX[Index] = OutEndPos.X; Out.EndY[Index] = OutEndPos.Y; Out.EndZ[Index] = OutEndPos.Z;
+
+		T Quat[4];
+		FindBetweenNormals((InitialJointPos - RootPos).GetSafeNormal(), (OutJointPos - RootPos).GetSafeNormal(), Quat);
+		Out.UpperRotX[Index] = Quat[0]; Out.UpperRotY[Index] = Quat[1]; Out.UpperRotZ[Index] = Quat[2]; Out.UpperRotW[Index] = Quat[3];
+		FindBetweenNormals((InitialEndPos - InitialJointPos).GetSafeNormal(), (OutEndPos - OutJointPos).GetSafeNormal(), Quat);
+		Out.LowerRotX[Index] = Quat[0]; Out.LowerRotY[Index] = Quat[1]; Out.LowerRotZ[Index] = Quat[2]; Out.LowerRotW[Index] = Quat[3];
+	}
+
+	template<typename T>
+	void SolveOld(const FootIKBatch::FLimbInput& In, const FootIKBatch::FLimbOutput& Out, const FootIKBatch::FSolveSettings& Settings, int Num)
+	{
+		for (int Index = 0; Index < Num; Index++)
+		{
+			SolveOldPerLimb<T>(In, Out, Settings, Index);
+		}
+	}
+
+	template<typename L>
+	void SolveWithLanes(const FootIKBatch::FLimbInput& In, const FootIKBatch::FLimbOutput& Out, const FootIKBatch::FSolveSettings& Settings, int Num)
+	{
+		int Index = 0;
+		for (; Index + L::Width <= Num; Index += L::Width)
+		{
+			FootIKBatch::SolveLanes<L>(In, Out, Settings, Index);
+		}
+		for (; Index < Num; Index++)
+		{
+			FootIKBatch::SolveLanes<FootIKBatch::FScalarLanes>(In, Out, Settings, Index);
+		}
+	}
+
+	float RandRange(float Min, float Max)
+	{
+		return Min + (Max - Min) * (float)rand() / (float)RAND_MAX;
+	}
+
+	/** legs of about character size with random targets, every few limbs hits one of the degenerate cases */
+	void FillInput(FBatch& Batch)
+	{
+		const int Num = (int)Batch.Arrays[0].size();
+		for (int Index = 0; Index < Num; Index++)
+		{
+			const float Root[3] = { RandRange(-20.f, 20.f), RandRange(-20.f, 20.f), RandRange(80.f, 100.f) };
+			const float Upper = RandRange(35.f, 50.f);
+			const float Lower = RandRange(35.f, 50.f);
+			const float Joint[3] = { Root[0] + RandRange(-5.f, 5.f), Root[1] + RandRange(5.f, 15.f), Root[2] - Upper };
+			const float End[3] = { Joint[0], Joint[1] - 5.f, Joint[2] - Lower };
+			float Target[3] = { Root[0] + RandRange(-60.f, 60.f), Root[1] + RandRange(-60.f, 60.f), Root[2] - RandRange(-20.f, 110.f) };
+			float Pole[3] = { Root[0] + RandRange(-10.f, 10.f), Root[1] + RandRange(20.f, 60.f), Root[2] - RandRange(0.f, 60.f) };
+
+			switch (Index % 16)
+			{
+			case 1:		// target at root
+				memcpy(Target, Root, sizeof(Target));
+				break;
+			case 2:		// joint target at root
+				memcpy(Pole, Root, sizeof(Pole));
+				break;
+			case 3:		// joint target on the root -> target line
+				for (int Axis = 0; Axis < 3; Axis++)
+				{
+					Pole[Axis] = Root[Axis] + (Target[Axis] - Root[Axis]) * 0.5f;
+				}
+				break;
+			case 4:		// straight down, on the line as well
+				Target[0] = Root[0]; Target[1] = Root[1];
+				Pole[0] = Root[0]; Pole[1] = Root[1]; Pole[2] = Root[2] - 10.f;
+				break;
+			case 5:		// far out of reach
+				Target[2] = Root[2] - 500.f;
+				break;
+			}
+
+			const float* Values[] = { Root, Joint, End, Target, Pole };
+			for (int Vector = 0; Vector < 5; Vector++)
+			{
+				for (int Axis = 0; Axis < 3; Axis++)
+				{
+					Batch.Arrays[Vector * 3 + Axis][Index] = Values[Vector][Axis];
+				}
+			}
+			Batch.Arrays[15][Index] = Upper;
+			Batch.Arrays[16][Index] = Lower;
+		}
+	}
+
+	/** compares output arrays bit for bit, prints the first difference and returns the number of differing values */
+	int CountBitDifferences(const FBatch& Expected, const FBatch& Actual)
+	{
+		int NumDifferences = 0;
+		for (int ArrayIndex = 17; ArrayIndex < 31; ArrayIndex++)
+		{
+			const std::vector<float>& E = Expected.Arrays[ArrayIndex];
+			const std::vector<float>& R = Actual.Arrays[ArrayIndex];
+			for (size_t Index = 0; Index < E.size(); Index++)
+			{
+				if (memcmp(&E[Index], &R[Index], sizeof(float)) != 0)
+				{
+					if (NumDifferences == 0)
+					{
+						printf("    array %d limb %d: %.9g != %.9g\n", ArrayIndex, (int)Index, E[Index], R[Index]);
+					}
+					NumDifferences++;
+				}
+			}
+		}
+		return NumDifferences;
+	}
+
+	/** largest absolute difference of arrays [First, Last) */
+	float MaxDifference(const FBatch& Expected, const FBatch& Actual, int First, int Last, int& OutLimb)
+	{
+		float MaxDiff = 0.f;
+		OutLimb = -1;
+		for (int ArrayIndex = First; ArrayIndex < Last; ArrayIndex++)
+		{
+			for (size_t Index = 0; Index < Expected.Arrays[ArrayIndex].size(); Index++)
+			{
+				const float Diff = fabsf(Expected.Arrays[ArrayIndex][Index] - Actual.Arrays[ArrayIndex][Index]);
+				if (!(Diff <= MaxDiff))
+				{
+					MaxDiff = Diff;
+					OutLimb = (int)Index;
+				}
+			}
+		}
+		return MaxDiff;
+	}
+
+	typedef void (*FSolveFunction)(const FootIKBatch::FLimbInput&, const FootIKBatch::FLimbOutput&, const FootIKBatch::FSolveSettings&, int);
+
+	/** returns ns per limb */
+	double Benchmark(FSolveFunction Solve, FBatch& Batch, const FootIKBatch::FSolveSettings& Settings)
+	{
+		const int Num = (int)Batch.Arrays[0].size();
+		Solve(Batch.In, Batch.Out, Settings, Num);
+
+		const std::chrono::high_resolution_clock::time_point Start = std::chrono::high_resolution_clock::now();
+		for (int Run = 0; Run < NumBenchmarkRuns; Run++)
+		{
+			Solve(Batch.In, Batch.Out, Settings, Num);
+		}
+		const std::chrono::duration<double, std::nano> Elapsed = std::chrono::high_resolution_clock::now() - Start;
+		return Elapsed.count() / ((double)NumBenchmarkRuns * Num);
+	}
+
+	struct FLaneType
+	{
+		const char* Name;
+		FSolveFunction Solve;
+	};
+}
+
+int main()
+{
+	srand(1234);
+
+	const FLaneType LaneTypes[] = {
+		{ "old per limb", &SolveOld<float> },
+		{ "scalar", &SolveWithLanes<FootIKBatch::FScalarLanes> },
+#if FOOTIK_BATCH_SSE
+		{ "sse", &SolveWithLanes<FootIKBatch::FSSELanes> },
+#endif
+#if FOOTIK_BATCH_AVX
+		{ "avx", &SolveWithLanes<FootIKBatch::FAVXLanes> },
+#endif
+		{ "Solve", &FootIKBatch::Solve },
+	};
+	const int NumLaneTypes = sizeof(LaneTypes) / sizeof(LaneTypes[0]);
+
+	int NumFailures = 0;
+	for (int bAllowStretching = 0; bAllowStretching < 2; bAllowStretching++)
+	{
+		FootIKBatch::FSolveSettings Settings;
+		Settings.bAllowStretching = bAllowStretching != 0;
+		Settings.StretchMin = 0.9f;
+		Settings.StretchMax = 1.2f;
+		printf("%d limbs, stretching %s\n", NumLimbs, Settings.bAllowStretching ? "on" : "off");
+
+		FBatch Reference(NumLimbs);
+		FBatch Old(NumLimbs);
+		FBatch Scalar(NumLimbs);
+		FillInput(Reference);
+		Old.CopyInput(Reference);
+		Scalar.CopyInput(Reference);
+		SolveOld<double>(Reference.In, Reference.Out, Settings, NumLimbs);
+		SolveOld<float>(Old.In, Old.Out, Settings, NumLimbs);
+		FootIKBatch::SolveScalar(Scalar.In, Scalar.Out, Settings, NumLimbs);
+
+		// float acos loses precision close to straight legs, so both solvers are measured against the old one computed in double
+		int PositionLimb, RotationLimb;
+		const float OldPositionError = MaxDifference(Reference, Old, 17, 23, PositionLimb);
+		const float OldRotationError = MaxDifference(Reference, Old, 23, 31, RotationLimb);
+		printf("  old solver error:   position %.3g (limb %d), rotation %.3g (limb %d)\n", OldPositionError, PositionLimb, OldRotationError, RotationLimb);
+
+		const float PositionError = MaxDifference(Reference, Scalar, 17, 23, PositionLimb);
+		const float RotationError = MaxDifference(Reference, Scalar, 23, 31, RotationLimb);
+		const bool bAccurate = PositionError <= PositionTolerance && RotationError <= RotationTolerance;
+		printf("  batch solver error: position %.3g (limb %d), rotation %.3g (limb %d) %s\n",
+			PositionError, PositionLimb, RotationError, RotationLimb, bAccurate ? "ok" : "FAILED");
+		NumFailures += bAccurate ? 0 : 1;
+
+		for (int LaneTypeIndex = 0; LaneTypeIndex < NumLaneTypes; LaneTypeIndex++)
+		{
+			const FLaneType& LaneType = LaneTypes[LaneTypeIndex];
+			FBatch Batch(NumLimbs);
+			Batch.CopyInput(Old);
+			Batch.PoisonOutput();
+			LaneType.Solve(Batch.In, Batch.Out, Settings, NumLimbs);
+
+			// the old solver is only expected to be close, all lane types have to match scalar exactly
+			const bool bCompare = LaneType.Solve != &SolveOld<float>;
+			const int NumDifferences = bCompare ? CountBitDifferences(Scalar, Batch) : 0;
+			NumFailures += NumDifferences > 0 ? 1 : 0;
+
+			const double NsPerLimb = Benchmark(LaneType.Solve, Batch, Settings);
+			printf("  %-12s %7.2f ns/limb  %s\n", LaneType.Name, NsPerLimb, !bCompare ? "" : (NumDifferences == 0 ? "bit identical to scalar" : "DIFFERS from scalar"));
+		}
+	}
+
+	printf(NumFailures == 0 ? "all checks passed\n" : "%d checks FAILED\n", NumFailures);
+	return NumFailures == 0 ? 0 : 1;
+}
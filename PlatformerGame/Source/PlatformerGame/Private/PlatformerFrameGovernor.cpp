@@ -0,0 +1,141 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerFrameGovernor.h"
+
+namespace PlatformerFrameGovernor
+{
+	/** knob values of one step */
+	struct FLevel
+	{
+		/** platformer.HUDTimerInterval */
+		float HUDTimerInterval;
+
+		/** footik.MinLODLevel */
+		int32 FootIKMinLODLevel;
+	};
+
+	/** steps from full quality to cheapest, cheap knobs go first */
+	static const FLevel Levels[] =
+	{
+		{ 0.0f,  0 },
+		{ 0.1f,  0 },
+		{ 0.25f, 0 },
+		{ 0.25f, 1 },
+	};
+
+	/** frame time over this part of the budget counts as over budget */
+	static const float OverBudgetRatio = 0.95f;
+
+	/** frame time under this part of the budget counts as having room for a better step */
+	static const float UnderBudgetRatio = 0.7f;
+
+	/** seconds over budget before degrading a step */
+	static const float DegradeDelay = 1.0f;
+
+	/** seconds under budget before restoring a step, longer than DegradeDelay so steps don't oscillate */
+	static const float RestoreDelay = 4.0f;
+
+	/** weight of the last frame in the smoothed frame time */
+	static const float SmoothingFactor = 0.1f;
+
+	static void SetConsoleVariable(const TCHAR* Name, float Value)
+	{
+		IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(Name);
+		if (CVar)
+		{
+			CVar->Set(Value, ECVF_SetByCode);
+		}
+	}
+}
+
+FPlatformerFrameGovernor::FPlatformerFrameGovernor()
+	: TargetFrameRate(0)
+	, Level(0)
+	, AverageFrameTimeMs(0.0f)
+	, OverBudgetTime(0.0f)
+	, UnderBudgetTime(0.0f)
+{
+}
+
+FPlatformerFrameGovernor::~FPlatformerFrameGovernor()
+{
+	if (TargetFrameRate > 0)
+	{
+		SetTargetFrameRate(0);
+	}
+}
+
+void FPlatformerFrameGovernor::SetTargetFrameRate(int32 InTargetFrameRate)
+{
+	TargetFrameRate = FMath::Max(InTargetFrameRate, 0);
+	AverageFrameTimeMs = 0.0f;
+	OverBudgetTime = 0.0f;
+	UnderBudgetTime = 0.0f;
+
+	ApplyFrameRateCap();
+	ApplyLevel(0);
+}
+
+void FPlatformerFrameGovernor::ApplyFrameRateCap() const
+{
+	// rendering faster than the target only makes frame time uneven
+	PlatformerFrameGovernor::SetConsoleVariable(TEXT("t.MaxFPS"), (float)TargetFrameRate);
+}
+
+void FPlatformerFrameGovernor::ApplyLevel(int32 NewLevel)
+{
+	using namespace PlatformerFrameGovernor;
+
+	Level = FMath::Clamp(NewLevel, 0, (int32)ARRAY_COUNT(Levels) - 1);
+	SetConsoleVariable(TEXT("platformer.HUDTimerInterval"), Levels[Level].HUDTimerInterval);
+	SetConsoleVariable(TEXT("footik.MinLODLevel"), (float)Levels[Level].FootIKMinLODLevel);
+
+	UE_LOG(LogPlatformer, Verbose, TEXT("Frame governor at step %d for %d fps"), Level, TargetFrameRate);
+}
+
+void FPlatformerFrameGovernor::Tick(float DeltaTime)
+{
+	using namespace PlatformerFrameGovernor;
+
+	// anim evaluation runs on worker threads but the game thread waits for it, so it's part of game thread time
+	const float BudgetMs = 1000.0f / TargetFrameRate;
+	const float FrameTimeMs = FPlatformTime::ToMilliseconds(FMath::Max(GGameThreadTime, GRenderThreadTime));
+	AverageFrameTimeMs = AverageFrameTimeMs > 0.0f ? FMath::Lerp(AverageFrameTimeMs, FrameTimeMs, SmoothingFactor) : FrameTimeMs;
+
+	if (AverageFrameTimeMs > BudgetMs * OverBudgetRatio)
+	{
+		UnderBudgetTime = 0.0f;
+		OverBudgetTime += DeltaTime;
+		if (OverBudgetTime >= DegradeDelay && Level < (int32)ARRAY_COUNT(Levels) - 1)
+		{
+			OverBudgetTime = 0.0f;
+			ApplyLevel(Level + 1);
+		}
+	}
+	else if (AverageFrameTimeMs < BudgetMs * UnderBudgetRatio)
+	{
+		OverBudgetTime = 0.0f;
+		UnderBudgetTime += DeltaTime;
+		if (UnderBudgetTime >= RestoreDelay && Level > 0)
+		{
+			UnderBudgetTime = 0.0f;
+			ApplyLevel(Level - 1);
+		}
+	}
+	else
+	{
+		OverBudgetTime = 0.0f;
+		UnderBudgetTime = 0.0f;
+	}
+}
+
+bool FPlatformerFrameGovernor::IsTickable() const
+{
+	return TargetFrameRate > 0;
+}
+
+TStatId FPlatformerFrameGovernor::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FPlatformerFrameGovernor, STATGROUP_Tickables);
+}
@@ -1,18 +1,26 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "PlatformerGame.h"
+#include "PlatformerRecordStore.h"
+#include "PlatformerHUD.h"
+#include "PlatformerTrace.h"
 
 
 class FPlatformerGameModule : public FDefaultGameModuleImpl
 {
 	virtual void StartupModule() override
 	{
-
+		PLATFORMER_TRACE_SCOPE(TEXT("PlatformerGame.StartupModule"));
 	}
 
 	virtual void ShutdownModule() override
 	{
-	
+		// records are written in the background, make sure the last ones hit the disk
+		// while the thread pool is still around, the store itself is only destroyed with other statics
+		FPlatformerRecordStore::Get().WaitForWriteTasks();
+		FPlatformerRecordStore::Get().Flush();
+
+		APlatformerHUD::ReleaseAssets();
 	}
 };
 
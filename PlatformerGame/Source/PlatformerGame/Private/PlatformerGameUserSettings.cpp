@@ -8,15 +8,45 @@ UPlatformerGameUserSettings::UPlatformerGameUserSettings(const FObjectInitialize
 	: Super(ObjectInitializer)
 {
 	SoundVolume = 1.0f;
+	TargetFrameRate = 0;
 }
 
 void UPlatformerGameUserSettings::ApplySettings(bool bCheckForCommandLineOverrides)
 {
-	Super::ApplySettings(bCheckForCommandLineOverrides);
-	if (GEngine && GEngine->GetMainAudioDevice())
+	// changing video mode resizes the viewport, only do it when resolution or window mode changed.
+	// Inherited settings (vsync, scalability, frame rate limit) aren't all covered by IsDirty, so they are always applied
+	if (bCheckForCommandLineOverrides || IsScreenResolutionDirty() || IsFullscreenModeDirty())
+	{
+		ApplyResolutionSettings(bCheckForCommandLineOverrides);
+	}
+
+	// before the inherited settings, so turning the governor off leaves the inherited frame rate limit in t.MaxFPS
+	if (IsTargetFrameRateDirty())
+	{
+		if (!FrameGovernor.IsValid())
+		{
+			FrameGovernor = MakeShareable(new FPlatformerFrameGovernor());
+		}
+		FrameGovernor->SetTargetFrameRate(TargetFrameRate);
+	}
+
+	ApplyNonResolutionSettings();
+
+	// ApplyNonResolutionSettings wrote the inherited frame rate limit to t.MaxFPS, the governor's cap wins while it's on
+	if (FrameGovernor.IsValid() && FrameGovernor->GetTargetFrameRate() > 0)
+	{
+		FrameGovernor->ApplyFrameRateCap();
+	}
+
+	if (IsSoundVolumeDirty())
 	{
 		GEngine->GetMainAudioDevice()->TransientMasterVolume = SoundVolume;
 	}
+
+	SaveSettings();
+
+	// same as the inherited ApplySettings, so the settings UI picks up the new values
+	RequestUIUpdate();
 }
 
 bool UPlatformerGameUserSettings::IsSoundVolumeDirty() const
@@ -30,7 +60,13 @@ bool UPlatformerGameUserSettings::IsSoundVolumeDirty() const
 	return bIsDirty;
 }
 
+bool UPlatformerGameUserSettings::IsTargetFrameRateDirty() const
+{
+	const int32 CurrentFrameRate = FrameGovernor.IsValid() ? FrameGovernor->GetTargetFrameRate() : 0;
+	return CurrentFrameRate != FMath::Max(TargetFrameRate, 0);
+}
+
 bool UPlatformerGameUserSettings::IsDirty() const
 {
-	return Super::IsDirty() || IsSoundVolumeDirty();
+	return Super::IsDirty() || IsSoundVolumeDirty() || IsTargetFrameRateDirty();
 }
\ No newline at end of file
@@ -3,12 +3,20 @@
 #include "PlatformerGame.h"
 #include "PlatformerGame_Menu.h"
 #include "Player/PlatformerPlayerController_Menu.h"
+#include "PlatformerHUD.h"
 
 APlatformerGame_Menu::APlatformerGame_Menu(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PlayerControllerClass = APlatformerPlayerController_Menu::StaticClass();
 }
 
+void APlatformerGame_Menu::BeginPlay()
+{
+	Super::BeginPlay();
+
+	APlatformerHUD::RequestAssets();
+}
+
 void APlatformerGame_Menu::RestartPlayer(class AController* NewPlayer)
 {
 	// don't restart
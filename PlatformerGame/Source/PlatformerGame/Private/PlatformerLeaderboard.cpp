@@ -0,0 +1,137 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerLeaderboard.h"
+#include "PlatformerHUD.h"
+
+int32 FPlatformerLeaderboard::UpperBound(float Time) const
+{
+	int32 First = 0;
+	int32 Last = Entries.Num();
+	while (First < Last)
+	{
+		const int32 Middle = First + (Last - First) / 2;
+		if (Entries[Middle].Time <= Time)
+		{
+			First = Middle + 1;
+		}
+		else
+		{
+			Last = Middle;
+		}
+	}
+	return First;
+}
+
+int32 FPlatformerLeaderboard::GetRank(float Time) const
+{
+	const int32 Rank = UpperBound(Time);
+	return Rank < MaxEntries ? Rank : INDEX_NONE;
+}
+
+int32 FPlatformerLeaderboard::Submit(float Time, const FString& Name)
+{
+	const int32 Rank = GetRank(Time);
+	if (Rank != INDEX_NONE)
+	{
+		if (Entries.Num() >= MaxEntries)
+		{
+			Entries.RemoveAt(Entries.Num() - 1, 1, false);
+		}
+		Entries.Insert(FPlatformerHighscore(Time, Name), Rank);
+	}
+	return Rank;
+}
+
+void FPlatformerLeaderboard::SetMaxEntries(int32 InMaxEntries)
+{
+	MaxEntries = FMath::Max(InMaxEntries, 0);
+	if (Entries.Num() > MaxEntries)
+	{
+		Entries.RemoveAt(MaxEntries, Entries.Num() - MaxEntries);
+	}
+}
+
+UPlatformerLeaderboardLibrary::UPlatformerLeaderboardLibrary(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+FPlatformerLeaderboard UPlatformerLeaderboardLibrary::MakeLeaderboard(const TArray<float>& Times, const TArray<FString>& Names, int32 MaxEntries)
+{
+	FPlatformerLeaderboard Leaderboard;
+	Leaderboard.SetMaxEntries(MaxEntries);
+	Leaderboard.Entries.Reserve(FMath::Min(Times.Num(), Leaderboard.MaxEntries));
+
+	const int32 NumScores = FMath::Min(Times.Num(), Names.Num());
+	for (int32 i = 0; i < NumScores; i++)
+	{
+		Leaderboard.Submit(Times[i], Names[i]);
+	}
+	return Leaderboard;
+}
+
+int32 UPlatformerLeaderboardLibrary::SubmitHighscore(FPlatformerLeaderboard& Leaderboard, float Time, const FString& Name)
+{
+	return Leaderboard.Submit(Time, Name);
+}
+
+int32 UPlatformerLeaderboardLibrary::GetHighscoreRank(const FPlatformerLeaderboard& Leaderboard, float Time)
+{
+	return Leaderboard.GetRank(Time);
+}
+
+void UPlatformerLeaderboardLibrary::BreakLeaderboard(const FPlatformerLeaderboard& Leaderboard, TArray<float>& OutTimes, TArray<FString>& OutNames)
+{
+	OutTimes.Reset(Leaderboard.Entries.Num());
+	OutNames.Reset(Leaderboard.Entries.Num());
+	for (const FPlatformerHighscore& Entry : Leaderboard.Entries)
+	{
+		OutTimes.Add(Entry.Time);
+		OutNames.Add(Entry.Name);
+	}
+}
+
+void UPlatformerLeaderboardLibrary::ShowLeaderboard(UObject* WorldContextObject, const FPlatformerLeaderboard& Leaderboard)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, false);
+	APlayerController* LocalPC = World ? GEngine->GetFirstLocalPlayerController(World) : nullptr;
+	APlatformerHUD* MyHUD = LocalPC ? Cast<APlatformerHUD>(LocalPC->GetHUD()) : nullptr;
+	if (MyHUD)
+	{
+		MyHUD->ShowLeaderboard(Leaderboard);
+	}
+}
+
+FPlatformerLeaderboard UPlatformerLeaderboardLibrary::GetSavedLeaderboard()
+{
+	return FPlatformerRecordStore::Get().GetLeaderboard();
+}
+
+int32 UPlatformerLeaderboardLibrary::SaveHighscore(float Time, const FString& Name)
+{
+	return FPlatformerRecordStore::Get().AddHighscore(Time, Name);
+}
+
+void UPlatformerLeaderboardLibrary::PreloadRecords()
+{
+	FPlatformerRecordStore::Get().Preload();
+}
+
+void UPlatformerLeaderboardLibrary::LoadBestCheckpointTimes(TArray<float>& OutTimes)
+{
+	OutTimes = FPlatformerRecordStore::Get().GetBestSplits();
+}
+
+void UPlatformerLeaderboardLibrary::SaveRun(const TArray<float>& CheckpointTimes)
+{
+	FPlatformerRecordStore::Get().AddRun(CheckpointTimes);
+}
+
+void UPlatformerLeaderboardLibrary::SortHighscores(const TArray<float>& InTimes, const TArray<FString>& InNames, TArray<float>& OutTimes, TArray<FString>& OutNames, int32 MaxScores)
+{
+	// blueprints used to pass anything here since it was ignored, keep everything for non positive values
+	const int32 NumScores = FMath::Min(InTimes.Num(), InNames.Num());
+	const FPlatformerLeaderboard Leaderboard = MakeLeaderboard(InTimes, InNames, MaxScores > 0 ? MaxScores : NumScores);
+	BreakLeaderboard(Leaderboard, OutTimes, OutNames);
+}
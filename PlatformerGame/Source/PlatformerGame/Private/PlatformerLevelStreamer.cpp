@@ -0,0 +1,126 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerLevelStreamer.h"
+#include "Engine/LevelBounds.h"
+
+UPlatformerLevelStreamer::UPlatformerLevelStreamer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	LoadAheadTime = 2.0f;
+	LoadAheadDistance = 2000.0f;
+	UnloadBehindDistance = 4000.0f;
+}
+
+void UPlatformerLevelStreamer::InitSections(UWorld* World)
+{
+	SectionsWorld = World;
+	SectionStates.Reset(Sections.Num());
+
+	for (const FName& SectionName : Sections)
+	{
+		FSectionState& Section = SectionStates[SectionStates.AddZeroed()];
+		for (ULevelStreaming* StreamingLevel : World->StreamingLevels)
+		{
+			// PIE prefixes package names, config uses the plain ones
+			const FString ShortName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(StreamingLevel ? StreamingLevel->GetWorldAssetPackageName() : FString()));
+			if (StreamingLevel && SectionName == FName(*ShortName))
+			{
+				Section.StreamingLevel = StreamingLevel;
+				break;
+			}
+		}
+	}
+}
+
+void UPlatformerLevelStreamer::UpdateBounds(FSectionState& Section)
+{
+	ULevel* Level = Section.StreamingLevel->GetLoadedLevel();
+	if (!Section.bBoundsKnown && Level)
+	{
+		const FBox Bounds = ALevelBounds::CalculateLevelBounds(Level);
+		if (Bounds.IsValid)
+		{
+			Section.MinX = Bounds.Min.X;
+			Section.MaxX = Bounds.Max.X;
+			Section.bBoundsKnown = true;
+		}
+	}
+}
+
+bool UPlatformerLevelStreamer::SetSectionLoaded(FSectionState& Section, bool bShouldBeLoaded, bool bBlockOnLoad)
+{
+	ULevelStreaming* StreamingLevel = Section.StreamingLevel.Get();
+	if (StreamingLevel->bShouldBeLoaded == bShouldBeLoaded && StreamingLevel->bShouldBeVisible == bShouldBeLoaded &&
+		StreamingLevel->bShouldBlockOnLoad == bBlockOnLoad)
+	{
+		return false;
+	}
+
+	StreamingLevel->bShouldBeLoaded = bShouldBeLoaded;
+	StreamingLevel->bShouldBeVisible = bShouldBeLoaded;
+	StreamingLevel->bShouldBlockOnLoad = bBlockOnLoad;
+	return true;
+}
+
+void UPlatformerLevelStreamer::UpdateStreaming(float ViewCenterX, float ViewHalfWidth, const FVector& PawnLocation, const FVector& PawnVelocity)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+	if (SectionsWorld.Get() != World)
+	{
+		InitSections(World);
+	}
+
+	// loading starts early enough for the section to arrive before it scrolls into view,
+	// and loaded sections are kept a bit longer than needed so a restart doesn't reload all of them
+	const float ViewMinX = ViewCenterX - ViewHalfWidth;
+	const float LoadMaxX = ViewCenterX + ViewHalfWidth + LoadAheadDistance + FMath::Max(PawnVelocity.X, 0.0f) * LoadAheadTime;
+	const float KeepMinX = ViewMinX - UnloadBehindDistance;
+	const float KeepMaxX = LoadMaxX + LoadAheadDistance;
+
+	bool bChanged = false;
+	const FSectionState* PrevSection = nullptr;
+	for (FSectionState& Section : SectionStates)
+	{
+		if (!Section.StreamingLevel.IsValid())
+		{
+			continue;
+		}
+
+		UpdateBounds(Section);
+
+		const bool bLoaded = Section.StreamingLevel->GetLoadedLevel() != nullptr;
+		if (Section.bBoundsKnown)
+		{
+			const bool bInLoadRange = Section.MaxX >= ViewMinX && Section.MinX <= LoadMaxX;
+			const bool bInKeepRange = Section.MaxX >= KeepMinX && Section.MinX <= KeepMaxX;
+			const bool bUnderPawn = PawnLocation.X >= Section.MinX && PawnLocation.X <= Section.MaxX;
+
+			// the runner was teleported (round restart) or outran streaming, the floor has to be there right now
+			const bool bBlockOnLoad = bUnderPawn && !bLoaded;
+			bChanged |= SetSectionLoaded(Section, bInLoadRange || bUnderPawn || (bLoaded && bInKeepRange), bBlockOnLoad);
+		}
+		else
+		{
+			// extents are unknown until first load, so the street is discovered in order:
+			// the next section is loaded once the end of the previous one gets close
+			const bool bReached = PrevSection == nullptr || (PrevSection->bBoundsKnown && PrevSection->MaxX <= LoadMaxX);
+			if (bReached)
+			{
+				const bool bBlockOnLoad = PrevSection && PrevSection->bBoundsKnown && PawnLocation.X > PrevSection->MaxX;
+				bChanged |= SetSectionLoaded(Section, true, bBlockOnLoad);
+			}
+		}
+
+		PrevSection = &Section;
+	}
+
+	if (bChanged)
+	{
+		UE_LOG(LogPlatformer, Verbose, TEXT("Street streaming updated at X %.0f, loading up to X %.0f"), PawnLocation.X, LoadMaxX);
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerMapPreloader.h"
+
+FPlatformerMapPreloader& FPlatformerMapPreloader::Get()
+{
+	static FPlatformerMapPreloader Preloader;
+	return Preloader;
+}
+
+FPlatformerMapPreloader::FPlatformerMapPreloader()
+{
+	FCoreUObjectDelegates::PostLoadMap.AddRaw(this, &FPlatformerMapPreloader::OnPostLoadMap);
+}
+
+void FPlatformerMapPreloader::Preload(const FString& MapPackageName)
+{
+	RequestPackage(MapPackageName);
+}
+
+void FPlatformerMapPreloader::RequestPackage(const FString& PackageName)
+{
+	if (RequestedPackages.Contains(PackageName))
+	{
+		return;
+	}
+	RequestedPackages.Add(PackageName);
+
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateRaw(this, &FPlatformerMapPreloader::OnPackageLoaded));
+}
+
+void FPlatformerMapPreloader::OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	// travel may have happened meanwhile, the map doesn't need the preloaded package anymore
+	if (Result != EAsyncLoadingResult::Succeeded || LoadedPackage == nullptr || !RequestedPackages.Contains(PackageName.ToString()))
+	{
+		return;
+	}
+
+	// referencing the package alone doesn't keep the world inside it alive
+	UWorld* World = UWorld::FindWorldInPackage(LoadedPackage);
+	LoadedObjects.Add(World ? (UObject*)World : (UObject*)LoadedPackage);
+
+	// sublevels are only known once the persistent level is loaded, request the ones loaded with the map
+	if (World)
+	{
+		for (ULevelStreaming* StreamingLevel : World->StreamingLevels)
+		{
+			if (StreamingLevel && (StreamingLevel->ShouldBeAlwaysLoaded() || StreamingLevel->bShouldBeLoaded))
+			{
+				RequestPackage(StreamingLevel->GetWorldAssetPackageName());
+			}
+		}
+	}
+}
+
+void FPlatformerMapPreloader::OnPostLoadMap()
+{
+	Reset();
+}
+
+void FPlatformerMapPreloader::Reset()
+{
+	RequestedPackages.Reset();
+	LoadedObjects.Reset();
+}
+
+void FPlatformerMapPreloader::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(LoadedObjects);
+}
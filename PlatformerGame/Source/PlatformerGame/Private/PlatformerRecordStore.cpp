@@ -0,0 +1,306 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerRecordStore.h"
+
+FPlatformerRecordStore& FPlatformerRecordStore::Get()
+{
+	static FPlatformerRecordStore Store(FPaths::GameSavedDir() / TEXT("SaveGames") / TEXT("PlatformerRecords.bin"));
+	return Store;
+}
+
+FPlatformerRecordStore::FPlatformerRecordStore(const FString& InFilename)
+	: Filename(InFilename)
+	, bLoaded(false)
+	, NumLogRecords(0)
+{
+}
+
+void FPlatformerRecordStore::Preload()
+{
+	check(IsInGameThread());
+	if (bLoaded || LoadTask.IsValid())
+	{
+		return;
+	}
+
+	// LoadedData isn't touched on the game thread until EnsureLoaded waits for the task
+	LoadTask = Async<bool>(EAsyncExecution::ThreadPool, [this]()
+	{
+		return FFileHelper::LoadFileToArray(LoadedData, *Filename, FILEREAD_Silent);
+	});
+}
+
+const TArray<float>& FPlatformerRecordStore::GetBestSplits()
+{
+	EnsureLoaded();
+	return BestSplits;
+}
+
+const FPlatformerLeaderboard& FPlatformerRecordStore::GetLeaderboard()
+{
+	EnsureLoaded();
+	return Leaderboard;
+}
+
+void FPlatformerRecordStore::EnsureLoaded()
+{
+	check(IsInGameThread());
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	// only blocks if Preload wasn't called or its read is still running
+	const bool bFileRead = LoadTask.IsValid() ? LoadTask.Get() : FFileHelper::LoadFileToArray(LoadedData, *Filename, FILEREAD_Silent);
+	LoadTask = TFuture<bool>();
+
+	bool bValidFile = false;
+	bool bTruncated = false;
+	if (bFileRead)
+	{
+		FMemoryReader Reader(LoadedData);
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Reader << Magic;
+		Reader << Version;
+		bValidFile = !Reader.IsError() && Magic == FileMagic && Version == FileVersion;
+
+		// a record cut short by a crash while appending ends the log, everything before it is kept
+		while (bValidFile && !Reader.AtEnd())
+		{
+			uint8 Type = 0;
+			Reader << Type;
+
+			if (Type == Record_Run)
+			{
+				int32 NumSplits = 0;
+				Reader << NumSplits;
+				if (Reader.IsError() || NumSplits < 0 || NumSplits > MaxSplits)
+				{
+					break;
+				}
+
+				TArray<float> Splits;
+				Splits.SetNumUninitialized(NumSplits);
+				for (float& Split : Splits)
+				{
+					Reader << Split;
+				}
+				if (Reader.IsError())
+				{
+					break;
+				}
+				ApplyRun(Splits);
+			}
+			else if (Type == Record_Highscore)
+			{
+				float Time = 0.0f;
+				uint8 NameLength = 0;
+				Reader << Time;
+				Reader << NameLength;
+
+				ANSICHAR NameUTF8[256];
+				Reader.Serialize(NameUTF8, NameLength);
+				if (Reader.IsError())
+				{
+					break;
+				}
+				FUTF8ToTCHAR Name(NameUTF8, NameLength);
+				Leaderboard.Submit(Time, FString(Name.Length(), Name.Get()));
+			}
+			else
+			{
+				break;
+			}
+			NumLogRecords++;
+		}
+		bTruncated = bValidFile && !Reader.AtEnd();
+
+		if (!bValidFile)
+		{
+			UE_LOG(LogPlatformer, Warning, TEXT("Discarding records in %s, unknown format or version"), *Filename);
+		}
+		else if (bTruncated)
+		{
+			UE_LOG(LogPlatformer, Warning, TEXT("Discarding damaged records at the end of %s"), *Filename);
+		}
+	}
+	LoadedData.Empty();
+
+	// the log always starts with a snapshot, so appends have a valid header to go after,
+	// and a damaged tail is dropped so appends don't end up after bytes that can't be read
+	if (!bValidFile || bTruncated || NumLogRecords > MaxRecordsBeforeCompaction)
+	{
+		QueueSnapshot();
+	}
+}
+
+void FPlatformerRecordStore::ApplyRun(const TArray<float>& Splits)
+{
+	if (BestSplits.Num() < Splits.Num())
+	{
+		const int32 OldNum = BestSplits.Num();
+		BestSplits.SetNumUninitialized(Splits.Num());
+		for (int32 i = OldNum; i < BestSplits.Num(); i++)
+		{
+			BestSplits[i] = -1.0f;
+		}
+	}
+
+	for (int32 i = 0; i < Splits.Num(); i++)
+	{
+		if (Splits[i] >= 0.0f && (BestSplits[i] < 0.0f || BestSplits[i] > Splits[i]))
+		{
+			BestSplits[i] = Splits[i];
+		}
+	}
+}
+
+void FPlatformerRecordStore::WriteRun(FArchive& Ar, const TArray<float>& Splits)
+{
+	uint8 Type = Record_Run;
+	int32 NumSplits = FMath::Min(Splits.Num(), (int32)MaxSplits);
+	Ar << Type;
+	Ar << NumSplits;
+	for (int32 i = 0; i < NumSplits; i++)
+	{
+		float Split = Splits[i];
+		Ar << Split;
+	}
+}
+
+void FPlatformerRecordStore::WriteHighscore(FArchive& Ar, float Time, const FString& Name)
+{
+	FTCHARToUTF8 NameUTF8(*Name);
+	uint8 Type = Record_Highscore;
+	uint8 NameLength = (uint8)FMath::Min(NameUTF8.Length(), 255);
+	Ar << Type;
+	Ar << Time;
+	Ar << NameLength;
+	Ar.Serialize((void*)NameUTF8.Get(), NameLength);
+}
+
+void FPlatformerRecordStore::AddRun(const TArray<float>& Splits)
+{
+	EnsureLoaded();
+	ApplyRun(Splits);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	WriteRun(Writer, Splits);
+	QueueWrite(Data, false);
+}
+
+int32 FPlatformerRecordStore::AddHighscore(float Time, const FString& Name)
+{
+	EnsureLoaded();
+	const int32 Rank = Leaderboard.Submit(Time, Name);
+
+	// times that didn't make it to the board would be dropped by the next snapshot anyway
+	if (Rank != INDEX_NONE)
+	{
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+		WriteHighscore(Writer, Time, Name);
+		QueueWrite(Data, false);
+	}
+	return Rank;
+}
+
+void FPlatformerRecordStore::QueueSnapshot()
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	Writer << Magic;
+	Writer << Version;
+
+	WriteRun(Writer, BestSplits);
+	for (const FPlatformerHighscore& Entry : Leaderboard.Entries)
+	{
+		WriteHighscore(Writer, Entry.Time, Entry.Name);
+	}
+
+	NumLogRecords = 1 + Leaderboard.Entries.Num();
+	QueueWrite(Data, true);
+}
+
+void FPlatformerRecordStore::QueueWrite(TArray<uint8>& Data, bool bReplaceFile)
+{
+	check(IsInGameThread());
+
+	FPendingWrite PendingWrite;
+	Exchange(PendingWrite.Data, Data);
+	PendingWrite.bReplaceFile = bReplaceFile;
+	PendingWrites.Enqueue(PendingWrite);
+
+	if (!bReplaceFile && ++NumLogRecords > MaxRecordsBeforeCompaction)
+	{
+		QueueSnapshot();
+		return;
+	}
+
+	WriteTasks.RemoveAll([](const TFuture<void>& WriteTask) { return WriteTask.IsReady(); });
+	WriteTasks.Add(Async<void>(EAsyncExecution::ThreadPool, [this]()
+	{
+		WritePending();
+	}));
+}
+
+void FPlatformerRecordStore::WritePending()
+{
+	FScopeLock Lock(&WriteCritical);
+
+	FPendingWrite PendingWrite;
+	while (PendingWrites.Dequeue(PendingWrite))
+	{
+		if (PendingWrite.bReplaceFile)
+		{
+			// written aside and moved over, so a crash never leaves a half written snapshot
+			const FString TempFilename = Filename + TEXT(".tmp");
+			if (!FFileHelper::SaveArrayToFile(PendingWrite.Data, *TempFilename) ||
+				!IFileManager::Get().Move(*Filename, *TempFilename, true))
+			{
+				UE_LOG(LogPlatformer, Warning, TEXT("Failed to write records to %s"), *Filename);
+			}
+		}
+		else
+		{
+			FArchive* Writer = IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_Append);
+			if (Writer)
+			{
+				Writer->Serialize(PendingWrite.Data.GetData(), PendingWrite.Data.Num());
+				delete Writer;
+			}
+			else
+			{
+				UE_LOG(LogPlatformer, Warning, TEXT("Failed to append record to %s"), *Filename);
+			}
+		}
+	}
+}
+
+void FPlatformerRecordStore::Flush()
+{
+	WritePending();
+}
+
+void FPlatformerRecordStore::WaitForWriteTasks()
+{
+	check(IsInGameThread());
+	for (const TFuture<void>& WriteTask : WriteTasks)
+	{
+		// a task the pool never ran would block forever, Flush writes its records instead
+		if (!WriteTask.WaitFor(FTimespan::FromSeconds(MaxWriteTaskWaitSeconds)))
+		{
+			UE_LOG(LogPlatformer, Warning, TEXT("Gave up waiting for record writes to %s"), *Filename);
+			break;
+		}
+	}
+	WriteTasks.Reset();
+}
@@ -3,6 +3,7 @@
 #include "PlatformerGame.h"
 #include "PlatformerPlayerCameraManager.h"
 #include "PlatformerCharacter.h"
+#include "PlatformerLevelStreamer.h"
 
 APlatformerPlayerCameraManager::APlatformerPlayerCameraManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -17,6 +18,8 @@ APlatformerPlayerCameraManager::APlatformerPlayerCameraManager(const FObjectInit
 
 	CameraFixedRotation = FRotator(0.0f, -90.0f, 0.0f);
 	FixedCameraOffsetZ = 130.0f;
+
+	LevelStreamer = ObjectInitializer.CreateDefaultSubobject<UPlatformerLevelStreamer>(this, TEXT("LevelStreamer"));
 }
 
 void APlatformerPlayerCameraManager::UpdateViewTargetInternal(FTViewTarget& OutVT, float DeltaTime)
@@ -30,6 +33,14 @@ void APlatformerPlayerCameraManager::UpdateViewTargetInternal(FTViewTarget& OutV
 	FVector CurrentCameraZoomOffset = MinCameraZoomOffset + CurrentZoomAlpha * (MaxCameraZoomOffset - MinCameraZoomOffset);
 	OutVT.POV.Location = ViewLoc + CurrentCameraZoomOffset;
 	OutVT.POV.Rotation = CameraFixedRotation;
+
+	// the camera looks along -Y at the runner, so its distance and FOV give the visible span along X
+	APawn* MyPawn = PCOwner ? PCOwner->GetPawn() : NULL;
+	if (MyPawn && LevelStreamer)
+	{
+		const float ViewHalfWidth = CurrentCameraZoomOffset.Y * FMath::Tan(FMath::DegreesToRadians(OutVT.POV.FOV * 0.5f));
+		LevelStreamer->UpdateStreaming(OutVT.POV.Location.X, ViewHalfWidth, MyPawn->GetActorLocation(), MyPawn->GetVelocity());
+	}
 }
 
 void APlatformerPlayerCameraManager::SetFixedCameraOffsetZ(float InOffset)
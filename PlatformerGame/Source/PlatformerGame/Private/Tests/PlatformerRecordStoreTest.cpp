@@ -0,0 +1,64 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerRecordStore.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlatformerRecordStoreTruncationTest, "Platformer.RecordStore.Truncation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlatformerRecordStoreTruncationTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::AutomationTransientDir() / TEXT("PlatformerRecordsTruncation.bin");
+	IFileManager::Get().Delete(*Filename, false, true, true);
+
+	TArray<float> FirstRun;
+	FirstRun.Add(10.0f);
+	FirstRun.Add(20.0f);
+	FirstRun.Add(30.0f);
+
+	{
+		FPlatformerRecordStore Store(Filename);
+		Store.AddRun(FirstRun);
+		Store.AddHighscore(30.0f, TEXT("AAA"));
+		Store.WaitForWriteTasks();
+		Store.Flush();
+	}
+
+	// cut the highscore record short, as a crash while appending would
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+	{
+		AddError(TEXT("Record log wasn't written"));
+		return false;
+	}
+	Data.SetNum(Data.Num() - 2);
+	FFileHelper::SaveArrayToFile(Data, *Filename);
+
+	TArray<float> SecondRun;
+	SecondRun.Add(5.0f);
+	SecondRun.Add(-1.0f);
+	SecondRun.Add(40.0f);
+
+	{
+		FPlatformerRecordStore Store(Filename);
+		TestTrue(TEXT("Splits before the damaged record are kept"), Store.GetBestSplits() == FirstRun);
+		TestEqual(TEXT("Damaged highscore is dropped"), Store.GetLeaderboard().Entries.Num(), 0);
+		Store.AddRun(SecondRun);
+		Store.WaitForWriteTasks();
+		Store.Flush();
+	}
+
+	{
+		FPlatformerRecordStore Store(Filename);
+		const TArray<float>& BestSplits = Store.GetBestSplits();
+		TestEqual(TEXT("Number of splits after reload"), BestSplits.Num(), 3);
+		if (BestSplits.Num() == 3)
+		{
+			TestEqual(TEXT("Run appended after the damaged record is read back"), BestSplits[0], 5.0f);
+			TestEqual(TEXT("Missed checkpoint keeps the best time"), BestSplits[1], 20.0f);
+			TestEqual(TEXT("Slower checkpoint keeps the best time"), BestSplits[2], 30.0f);
+		}
+	}
+
+	IFileManager::Get().Delete(*Filename, false, true, true);
+	return true;
+}
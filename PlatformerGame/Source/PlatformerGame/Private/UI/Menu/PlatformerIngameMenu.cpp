@@ -5,12 +5,14 @@
 #include "PlatformerOptions.h"
 #include "PlatformerPlayerController.h"
 #include "PlatformerGameMode.h"
+#include "PlatformerTrace.h"
 
 #define LOCTEXT_NAMESPACE "PlatformerGame.HUD.Menu"
 
 // @note Construct isn't a good name as it can be confused with Slate interface
 void FPlatformerIngameMenu::MakeMenu(APlatformerPlayerController* InPCOwner)
 {
+	PLATFORMER_TRACE_SCOPE(TEXT("FPlatformerIngameMenu::MakeMenu"));
 	if (!GEngine || !GEngine->GameViewport)
 	{
 		return;
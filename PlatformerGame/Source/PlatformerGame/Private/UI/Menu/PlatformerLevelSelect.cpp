@@ -3,6 +3,7 @@
 #include "PlatformerGame.h"
 #include "PlatformerLevelSelect.h"
 #include "PlatformerGameLoadingScreen.h"
+#include "PlatformerMapPreloader.h"
 
 #define LOCTEXT_NAMESPACE "PlatformerGame.HUD.Menu"
 
@@ -13,6 +14,13 @@ void FPlatformerLevelSelect::MakeMenu(TWeakObjectPtr<APlayerController> _PCOwner
 	MenuTitle = LOCTEXT("LevelSelect", "SELECT LEVEL");
 	AddMenuItem(LOCTEXT("Streets", "STREETS"), this, &FPlatformerLevelSelect::OnUIPlayStreets);
 	AddMenuItem(LOCTEXT("Back", "BACK"), this, &FPlatformerLevelSelect::GoBack);
+	SetOnOpenHandler<FPlatformerLevelSelect>(this, &FPlatformerLevelSelect::OnMenuOpened);
+}
+
+void FPlatformerLevelSelect::OnMenuOpened()
+{
+	// player is likely to pick a level soon, get the map into memory while the menu is browsed
+	FPlatformerMapPreloader::Get().Preload(TEXT("/Game/Maps/Platformer_StreetSection"));
 }
 
 void FPlatformerLevelSelect::OnUIPlayStreets()
@@ -34,6 +42,8 @@ void FPlatformerLevelSelect::OnMenuHidden()
 
 void FPlatformerLevelSelect::GoBack()
 {
+	// no travel is coming to take over the preloaded map, don't keep it in memory on the main menu
+	FPlatformerMapPreloader::Get().Reset();
 	RootMenuPageWidget->MenuGoBack(false);
 }
 
@@ -10,6 +10,7 @@ public:
 	void MakeMenu(TWeakObjectPtr<APlayerController> _PCOwner);
 
 	void OnUIPlayStreets();
+	void OnMenuOpened();
 	void GoBack();
 	void ShowLoadingScreen();
 	void OnMenuHidden();
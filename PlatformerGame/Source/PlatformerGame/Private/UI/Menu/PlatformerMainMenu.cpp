@@ -4,11 +4,13 @@
 #include "PlatformerMainMenu.h"
 #include "PlatformerOptions.h"
 #include "PlatformerLevelSelect.h"
+#include "PlatformerTrace.h"
 
 #define LOCTEXT_NAMESPACE "PlatformerGame.HUD.Menu"
 
 void FPlatformerMainMenu::MakeMenu(APlayerController* InPCOwner)
 {
+	PLATFORMER_TRACE_SCOPE(TEXT("FPlatformerMainMenu::MakeMenu"));
 	TSharedRef<FPlatformerOptions> Options = MakeShareable(new FPlatformerOptions());
 	Options->MakeMenu(InPCOwner);
 	Options->ApplySettings();
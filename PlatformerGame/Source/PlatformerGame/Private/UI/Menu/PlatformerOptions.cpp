@@ -16,6 +16,7 @@ void FPlatformerOptions::MakeMenu(TWeakObjectPtr<APlayerController> _PCOwner)
 	TArray<FText> ResolutionList;
 	TArray<FText> OnOffList;
 	TArray<FText> VolumeList;
+	TArray<FText> FrameRateList;
 
 	// Build an array of resolutions available
 	for (int32 i = 0; i < PlatformerResCount; i++)
@@ -26,6 +27,12 @@ void FPlatformerOptions::MakeMenu(TWeakObjectPtr<APlayerController> _PCOwner)
 	OnOffList.Add(LOCTEXT("Off","OFF"));
 	OnOffList.Add(LOCTEXT("On","ON"));
 
+	FrameRateList.Add(LOCTEXT("Off","OFF"));
+	for (int32 i = 1; i < PlatformerFrameRateCount; i++)
+	{
+		FrameRateList.Add(FText::AsNumber(PlatformerFrameRates[i]));
+	}
+
 	// Volume 0-10
 	for (int32 i = 0; i < 11; i++)
 	{
@@ -36,6 +43,7 @@ void FPlatformerOptions::MakeMenu(TWeakObjectPtr<APlayerController> _PCOwner)
 	SoundVolumeOption = AddMenuItemWithOptions<FPlatformerOptions>(LOCTEXT("SoundVolume", "SOUND VOLUME"), VolumeList, this, &FPlatformerOptions::SoundVolumeOptionChanged);
 	VideoResolutionOption = AddMenuItemWithOptions<FPlatformerOptions>(LOCTEXT("Resolution", "RESOLUTION"), ResolutionList, this, &FPlatformerOptions::VideoResolutionOptionChanged);
 	FullScreenOption = AddMenuItemWithOptions<FPlatformerOptions>(LOCTEXT("FullScreen", "FULL SCREEN"), OnOffList, this, &FPlatformerOptions::FullScreenOptionChanged);
+	TargetFrameRateOption = AddMenuItemWithOptions<FPlatformerOptions>(LOCTEXT("TargetFPS", "TARGET FPS"), FrameRateList, this, &FPlatformerOptions::TargetFrameRateOptionChanged);
 	
 	// Setup some handlers for misc actions.
 	SetAcceptHandler<FPlatformerOptions>(this, &FPlatformerOptions::ApplySettings);
@@ -49,6 +57,7 @@ void FPlatformerOptions::MakeMenu(TWeakObjectPtr<APlayerController> _PCOwner)
 	SoundVolumeOpt = UserSettings->GetSoundVolume();
 	ResolutionOpt = UserSettings->GetScreenResolution();
 	bFullScreenOpt = UserSettings->GetFullscreenMode();
+	TargetFrameRateOpt = UserSettings->GetTargetFrameRate();
 }
 
 
@@ -58,6 +67,7 @@ void FPlatformerOptions::ApplySettings()
 	UserSettings->SetSoundVolume(SoundVolumeOpt);
 	UserSettings->SetScreenResolution(ResolutionOpt);
 	UserSettings->SetFullscreenMode(bFullScreenOpt);
+	UserSettings->SetTargetFrameRate(TargetFrameRateOpt);
 	UserSettings->ApplySettings(false);
 }
 
@@ -95,6 +105,20 @@ int32 FPlatformerOptions::GetCurrentResolutionIndex(FIntPoint CurrentRes)
 	return Result;
 }
 
+int32 FPlatformerOptions::GetCurrentFrameRateIndex(int32 CurrentFrameRate)
+{
+	int32 Result = 0; // governor is off if match not found
+	for (int32 i = 0; i < PlatformerFrameRateCount; i++)
+	{
+		if (PlatformerFrameRates[i] == CurrentFrameRate)
+		{
+			Result = i;
+			break;
+		}
+	}
+	return Result;
+}
+
 void FPlatformerOptions::UpdateOptions()
 {
 	//grab the user settings
@@ -102,6 +126,7 @@ void FPlatformerOptions::UpdateOptions()
 	VideoResolutionOption->SelectedMultiChoice = GetCurrentResolutionIndex(UserSettings->GetScreenResolution());
 	FullScreenOption->SelectedMultiChoice = UserSettings->GetFullscreenMode() != EWindowMode::Windowed ? 1 : 0;
 	SoundVolumeOption->SelectedMultiChoice = FMath::TruncToInt(UserSettings->GetSoundVolume() * 10.0f);
+	TargetFrameRateOption->SelectedMultiChoice = GetCurrentFrameRateIndex(UserSettings->GetTargetFrameRate());
 }
 
 void FPlatformerOptions::VideoResolutionOptionChanged(TSharedPtr<FGameMenuItem> MenuItem, int32 MultiOptionIndex)
@@ -121,4 +146,9 @@ void FPlatformerOptions::SoundVolumeOptionChanged(TSharedPtr<FGameMenuItem> Menu
 	SoundVolumeOpt = MultiOptionIndex / 10.0f;
 }
 
+void FPlatformerOptions::TargetFrameRateOptionChanged(TSharedPtr<FGameMenuItem> MenuItem, int32 MultiOptionIndex)
+{
+	TargetFrameRateOpt = PlatformerFrameRates[MultiOptionIndex];
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -9,6 +9,12 @@ const int32 PlatformerResCount = 4;
 /** supported resolutions */
 const FIntPoint PlatformerResolutions[PlatformerResCount] = { FIntPoint(800,600), FIntPoint(1024,768), FIntPoint(1280,720), FIntPoint(1920,1080) };
 
+/** supported target frame rates count */
+const int32 PlatformerFrameRateCount = 4;
+
+/** supported target frame rates, 0 turns the frame governor off */
+const int32 PlatformerFrameRates[PlatformerFrameRateCount] = { 0, 30, 60, 120 };
+
 /** delegate called when changes are applied */
 DECLARE_DELEGATE(FOnOptionsClosing);
 
@@ -56,9 +62,15 @@ protected:
 	/** sound volume option changed handler */
 	void SoundVolumeOptionChanged(TSharedPtr<FGameMenuItem> MenuItem, int32 MultiOptionIndex);
 
+	/** target frame rate option changed handler */
+	void TargetFrameRateOptionChanged(TSharedPtr<FGameMenuItem> MenuItem, int32 MultiOptionIndex);
+
 	/** try to match current resolution with selected index */
 	int32 GetCurrentResolutionIndex(FIntPoint CurrentRes);
 
+	/** try to match current target frame rate with selected index */
+	int32 GetCurrentFrameRateIndex(int32 CurrentFrameRate);
+
 	/** Owning player controller */
 	TWeakObjectPtr<APlayerController> PCOwner;
 
@@ -72,6 +84,9 @@ protected:
 	/** holds full screen option menu item */
 	TSharedPtr<FGameMenuItem> FullScreenOption;
 
+	/** holds target frame rate menu item */
+	TSharedPtr<FGameMenuItem> TargetFrameRateOption;
+
 	/** full screen setting set in options */
 	EWindowMode::Type bFullScreenOpt;
 
@@ -81,6 +96,9 @@ protected:
 	/** sound volume set in options */
 	float SoundVolumeOpt;
 
+	/** target frame rate set in options */
+	int32 TargetFrameRateOpt;
+
 	/** Sound to play when changes are accepted */
 	FSlateSound AcceptChangesSound;
 
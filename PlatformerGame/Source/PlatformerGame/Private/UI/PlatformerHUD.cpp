@@ -3,65 +3,301 @@
 #include "PlatformerGame.h"
 #include "PlatformerHUD.h"
 #include "Widgets/FPlatformerPicture.h"
+#include "Widgets/SPlatformerHUDWidget.h"
 #include "SlateBasics.h"
 #include "SlateExtras.h"
-#include "PlatformerBlueprintLibrary.h"
+#include "PlatformerTimeFormat.h"
+#include "PlatformerStringUtils.h"
 #include "PlatformerGameMode.h"
+#include "PlatformerTrace.h"
 
 #define LOCTEXT_NAMESPACE "PlatformerGame.HUD"
 
+static TAutoConsoleVariable<float> CVarHUDTimerInterval(
+	TEXT("platformer.HUDTimerInterval"),
+	0.0f,
+	TEXT("Seconds between round timer updates, 0 updates every frame."),
+	ECVF_Scalability);
+
+FPlatformerMessageQueue::FPlatformerMessageQueue()
+	: Count(0)
+{
+	for (int32 i = 0; i < Capacity; i++)
+	{
+		Order[i] = i;
+	}
+}
+
+bool FPlatformerMessageQueue::Add(const FString& Message, const FPlatformerMessageData& Params)
+{
+	// blueprints may post the same message several times in one frame
+	for (int32 i = 0; i < Count; i++)
+	{
+		const FPlatformerMessageData& Other = At(i);
+		if (Other.DisplayStartTime == Params.DisplayStartTime &&
+			Other.PosX == Params.PosX && Other.PosY == Params.PosY &&
+			Other.TextScale == Params.TextScale && Other.bRedBorder == Params.bRedBorder &&
+			Other.Message.Equals(Message, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+
+	if (Count == Capacity)
+	{
+		PopFront();
+	}
+
+	const int32 Slot = Order[Count];
+	FPlatformerMessageData& NewMessage = Messages[Slot];
+	NewMessage.DisplayDuration = Params.DisplayDuration;
+	NewMessage.DisplayStartTime = Params.DisplayStartTime;
+	NewMessage.PosX = Params.PosX;
+	NewMessage.PosY = Params.PosY;
+	NewMessage.TextScale = Params.TextScale;
+	NewMessage.bRedBorder = Params.bRedBorder;
+
+	FPlatformerStringUtils::AssignInPlace(NewMessage.Message, Message);
+
+	// insert from the back, keeping messages sorted by expiry time
+	const float ExpireTime = NewMessage.DisplayStartTime + NewMessage.DisplayDuration;
+	int32 Index = Count;
+	while (Index > 0 && At(Index - 1).DisplayStartTime + At(Index - 1).DisplayDuration > ExpireTime)
+	{
+		Order[Index] = Order[Index - 1];
+		--Index;
+	}
+	Order[Index] = Slot;
+	++Count;
+	return true;
+}
+
+int32 FPlatformerMessageQueue::RemoveExpired(float CurrTime)
+{
+	int32 NumRemoved = 0;
+	while (Count > 0 && CurrTime >= At(0).DisplayStartTime + At(0).DisplayDuration)
+	{
+		PopFront();
+		NumRemoved++;
+	}
+	return NumRemoved;
+}
+
+void FPlatformerMessageQueue::PopFront()
+{
+	check(Count > 0);
+	const int32 Slot = Order[0];
+	for (int32 i = 1; i < Count; i++)
+	{
+		Order[i - 1] = Order[i];
+	}
+	--Count;
+	Order[Count] = Slot;
+}
+
+/** HUD textures, streamed in on demand instead of being hard referenced by the class default object */
+enum EPlatformerHUDAsset
+{
+	HUDAsset_Border,
+	HUDAsset_Background,
+	HUDAsset_BorderLeft,
+	HUDAsset_BorderRight,
+	HUDAsset_BorderTop,
+	HUDAsset_BorderBottom,
+	HUDAsset_BorderRed,
+	HUDAsset_BackgroundRed,
+	HUDAsset_BorderLeftRed,
+	HUDAsset_BorderRightRed,
+	HUDAsset_BorderTopRed,
+	HUDAsset_BorderBottomRed,
+	HUDAsset_UpButton,
+	HUDAsset_DownButton,
+	HUDAsset_Count,
+};
+
+static const TArray<FStringAssetReference>& GetHUDAssets()
+{
+	static TArray<FStringAssetReference> Assets;
+	if (Assets.Num() == 0)
+	{
+		const TCHAR* Paths[HUDAsset_Count] =
+		{
+			TEXT("/Game/UI/HUD/Frame/Border.Border"),
+			TEXT("/Game/UI/HUD/Frame/Background.Background"),
+			TEXT("/Game/UI/HUD/Frame/BorderLeft.BorderLeft"),
+			TEXT("/Game/UI/HUD/Frame/BorderRight.BorderRight"),
+			TEXT("/Game/UI/HUD/Frame/BorderTop.BorderTop"),
+			TEXT("/Game/UI/HUD/Frame/BorderBottom.BorderBottom"),
+			TEXT("/Game/UI/HUD/Frame/BorderRed.BorderRed"),
+			TEXT("/Game/UI/HUD/Frame/BackgroundRed.BackgroundRed"),
+			TEXT("/Game/UI/HUD/Frame/BorderLeftRed.BorderLeftRed"),
+			TEXT("/Game/UI/HUD/Frame/BorderRightRed.BorderRightRed"),
+			TEXT("/Game/UI/HUD/Frame/BorderTopRed.BorderTopRed"),
+			TEXT("/Game/UI/HUD/Frame/BorderBottomRed.BorderBottomRed"),
+			TEXT("/Game/UI/HUD/UpButton.UpButton"),
+			TEXT("/Game/UI/HUD/DownButton.DownButton"),
+		};
+		for (const TCHAR* Path : Paths)
+		{
+			Assets.Add(FStringAssetReference(Path));
+		}
+	}
+	return Assets;
+}
+
+/** keeps streamed HUD textures referenced, created on first request */
+static FStreamableManager* HUDStreamable = nullptr;
+
+void APlatformerHUD::RequestAssets(FStreamableDelegate OnLoaded)
+{
+	if (HUDStreamable == nullptr)
+	{
+		HUDStreamable = new FStreamableManager();
+	}
+	HUDStreamable->RequestAsyncLoad(GetHUDAssets(), OnLoaded);
+}
+
+void APlatformerHUD::ReleaseAssets()
+{
+	delete HUDStreamable;
+	HUDStreamable = nullptr;
+}
+
+bool APlatformerHUD::ResolveAssets()
+{
+	const TArray<FStringAssetReference>& Assets = GetHUDAssets();
+	UTexture2D* Textures[HUDAsset_Count];
+	for (int32 i = 0; i < HUDAsset_Count; i++)
+	{
+		Textures[i] = Cast<UTexture2D>(Assets[i].ResolveObject());
+		if (Textures[i] == nullptr)
+		{
+			return false;
+		}
+	}
+
+	BlueBorder.Border = Textures[HUDAsset_Border];
+	BlueBorder.Background = Textures[HUDAsset_Background];
+	BlueBorder.LeftBorder = Textures[HUDAsset_BorderLeft];
+	BlueBorder.RightBorder = Textures[HUDAsset_BorderRight];
+	BlueBorder.TopBorder = Textures[HUDAsset_BorderTop];
+	BlueBorder.BottomBorder = Textures[HUDAsset_BorderBottom];
+
+	RedBorder.Border = Textures[HUDAsset_BorderRed];
+	RedBorder.Background = Textures[HUDAsset_BackgroundRed];
+	RedBorder.LeftBorder = Textures[HUDAsset_BorderLeftRed];
+	RedBorder.RightBorder = Textures[HUDAsset_BorderRightRed];
+	RedBorder.TopBorder = Textures[HUDAsset_BorderTopRed];
+	RedBorder.BottomBorder = Textures[HUDAsset_BorderBottomRed];
+
+	UpButtonTexture = Textures[HUDAsset_UpButton];
+	DownButtonTexture = Textures[HUDAsset_DownButton];
+	return true;
+}
+
 APlatformerHUD::APlatformerHUD(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
-	static ConstructorHelpers::FObjectFinder<UFont> HUDFontOb(TEXT("/Game/UI/HUD/RobotoLight48"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> BorderTextureOb(TEXT("/Game/UI/HUD/Frame/Border"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> BorderBackgroundTextureOb(TEXT("/Game/UI/HUD/Frame/Background"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> LeftBorderTextureOb(TEXT("/Game/UI/HUD/Frame/BorderLeft"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> RightBorderTextureOb(TEXT("/Game/UI/HUD/Frame/BorderRight"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> TopBorderTextureOb(TEXT("/Game/UI/HUD/Frame/BorderTop"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> BottomBorderTextureOb(TEXT("/Game/UI/HUD/Frame/BorderBottom"));
-
-	static ConstructorHelpers::FObjectFinder<UTexture2D> BorderRedTextureOb(TEXT("/Game/UI/HUD/Frame/BorderRed"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> BorderBackgroundRedTextureOb(TEXT("/Game/UI/HUD/Frame/BackgroundRed"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> LeftBorderRedTextureOb(TEXT("/Game/UI/HUD/Frame/BorderLeftRed"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> RightBorderRedTextureOb(TEXT("/Game/UI/HUD/Frame/BorderRightRed"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> TopBorderRedTextureOb(TEXT("/Game/UI/HUD/Frame/BorderTopRed"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> BottomBorderRedTextureOb(TEXT("/Game/UI/HUD/Frame/BorderBottomRed"));
-
-	static ConstructorHelpers::FObjectFinder<UTexture2D> UpButtonTextureOb(TEXT("/Game/UI/HUD/UpButton"));
-	static ConstructorHelpers::FObjectFinder<UTexture2D> DownButtonTextureOb(TEXT("/Game/UI/HUD/DownButton"));
-
-	UpButtonTexture = UpButtonTextureOb.Object;
-	DownButtonTexture = DownButtonTextureOb.Object;
-
-	HUDFont = HUDFontOb.Object;
-	
-	BlueBorder.Background = BorderBackgroundTextureOb.Object;
-	BlueBorder.Border = BorderTextureOb.Object;
-	BlueBorder.BottomBorder = BottomBorderTextureOb.Object;
-	BlueBorder.TopBorder = TopBorderTextureOb.Object;
-	BlueBorder.LeftBorder = LeftBorderTextureOb.Object;
-	BlueBorder.RightBorder =  RightBorderTextureOb.Object;
-
-	RedBorder.Background = BorderBackgroundRedTextureOb.Object;
-	RedBorder.Border = BorderRedTextureOb.Object;
-	RedBorder.BottomBorder = BottomBorderRedTextureOb.Object;
-	RedBorder.TopBorder = TopBorderRedTextureOb.Object;
-	RedBorder.LeftBorder = LeftBorderRedTextureOb.Object;
-	RedBorder.RightBorder =  RightBorderRedTextureOb.Object;
+	PLATFORMER_TRACE_SCOPE(TEXT("APlatformerHUD::APlatformerHUD"));
+
+	// textures are streamed in by RequestAssets, the widget is created once they arrive
+	UpButtonTexture = nullptr;
+	DownButtonTexture = nullptr;
+	FMemory::Memzero(BlueBorder);
+	FMemory::Memzero(RedBorder);
 
 	HighScoreName.Init('A',3);
 	CurrentLetter = 0;
 	bEnterNamePromptActive = false;
 	bHighscoreActive = false;
+	UIScale = 1.0f;
+	RoundTimerUpdateTime = -1.0f;
+
+	ShownInputPrompt = nullptr;
+	bMessagesDirty = false;
+	bEndingMessagesDirty = false;
+	bEndingMessagesShown = false;
+	bHighscoreDirty = false;
+	bHighscoreShown = false;
+	bNamePromptDirty = false;
+	bNamePromptShown = false;
+
+	HighscoreEntries.Init(FPlatformerHighscore(60.0f, TEXT("TST")), 10);
+	BuildHighscoreCells();
+
+	// summary shows total time and time difference
+	EndingMessages.Reserve(2);
+
+	InputMessageWaiting = FText::FromString(TEXT("Jump or Slide to start running"));
+	InputMessageFinished = FText::FromString(TEXT("Jump or Slide to play again"));
+	InputMessageDefault = FText::FromString(TEXT("Jump or Slide"));
+}
+
+void APlatformerHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// usually already streamed in while the menu was shown
+	if (ResolveAssets())
+	{
+		CreateHUDWidget();
+	}
+	else
+	{
+		RequestAssets(FStreamableDelegate::CreateUObject(this, &APlatformerHUD::OnAssetsLoaded));
+	}
+}
+
+void APlatformerHUD::OnAssetsLoaded()
+{
+	if (!HUDWidget.IsValid() && ResolveAssets())
+	{
+		CreateHUDWidget();
+	}
+}
+
+void APlatformerHUD::CreateHUDWidget()
+{
+	if (GEngine && GEngine->GameViewport)
+	{
+		SAssignNew(HUDWidget, SPlatformerHUDWidget)
+			.OwnerHUD(this)
+			.BlueBorder(&BlueBorder)
+			.RedBorder(&RedBorder)
+			.UpButtonTexture(UpButtonTexture)
+			.DownButtonTexture(DownButtonTexture)
+			.UIScale(TAttribute<float>::Create(TAttribute<float>::FGetter::CreateUObject(this, &APlatformerHUD::GetUIScale)));
+
+		GEngine->GameViewport->AddViewportWidgetContent(
+			SAssignNew(HUDWidgetContainer, SWeakWidget)
+			.PossiblyNullContent(HUDWidget.ToSharedRef())
+		);
+	}
+}
+
+void APlatformerHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (HUDWidgetContainer.IsValid() && GEngine && GEngine->GameViewport)
+	{
+		GEngine->GameViewport->RemoveViewportWidgetContent(HUDWidgetContainer.ToSharedRef());
+	}
+	HUDWidgetContainer.Reset();
+	HUDWidget.Reset();
 
-	HighscoreNames.Init("TST",10);
-	HighscoreTimes.Init(60.0f,10);
+	Super::EndPlay(EndPlayReason);
+}
+
+float APlatformerHUD::GetUIScale() const
+{
+	return UIScale;
 }
 
 void APlatformerHUD::NotifyHitBoxClick(FName BoxName)
 {
 	Super::NotifyHitBoxClick(BoxName);
 
+	// clicks come from the name prompt buttons, it has to show the new state
+	bNamePromptDirty = true;
+
 	if (BoxName.GetPlainNameString() == "Letter")
 	{
 		CurrentLetter = BoxName.GetNumber();
@@ -101,150 +337,50 @@ void APlatformerHUD::NotifyHitBoxClick(FName BoxName)
 
 void APlatformerHUD::ShowHighscore(TArray<float> Times, TArray<FString> Names)
 {
-	HighscoreNames = MoveTemp(Names);
-	HighscoreTimes = MoveTemp(Times);
-	bHighscoreActive = true;
-}
-
-void APlatformerHUD::ShowHighscorePrompt()
-{
-	bEnterNamePromptActive = true;
-	if (PlayerOwner)
+	const int32 NumRows = FMath::Min(Times.Num(), Names.Num());
+	HighscoreEntries.Reset(NumRows);
+	for (int32 i = 0; i < NumRows; i++)
 	{
-		PlayerOwner->bShowMouseCursor = bEnterNamePromptActive;
+		HighscoreEntries.Add(FPlatformerHighscore(Times[i], Names[i]));
 	}
+	BuildHighscoreCells();
+	bHighscoreActive = true;
+	bHighscoreDirty = true;
 }
 
-void APlatformerHUD::HideHighscore()
+void APlatformerHUD::ShowLeaderboard(const FPlatformerLeaderboard& Leaderboard)
 {
-	bHighscoreActive = false;
+	HighscoreEntries = Leaderboard.Entries;
+	BuildHighscoreCells();
+	bHighscoreActive = true;
+	bHighscoreDirty = true;
 }
 
-void APlatformerHUD::DrawHighscoreEntryPrompt()
+void APlatformerHUD::BuildHighscoreCells()
 {
-	const float SizeX = 90 * UIScale;
-	const float SizeY = 90 * UIScale;
-	const float DrawX = (Canvas->ClipX - SizeX*3) / 2.0f;
-	const float DrawY = (Canvas->ClipY - SizeY) / 2.0f;
-
-	const float UVL = 90.0f/128.0f;
-	const float TextScale = 1.8f;
-
-	FCanvasTileItem TileItem(FVector2D(DrawX+SizeX*CurrentLetter, DrawY), UpButtonTexture->Resource, 
-		FVector2D( SizeX, SizeY ),
-		FVector2D(0,0),FVector2D(UVL,UVL), FLinearColor::White);
-	TileItem.BlendMode = SE_BLEND_Translucent;
-	if (HighScoreName[CurrentLetter] < 'Z')
+	HighscoreCells.Reset(HighscoreEntries.Num() * 3);
+	for (int32 i = 0; i < HighscoreEntries.Num(); i++)
 	{
-		Canvas->DrawItem(TileItem);
-		AddHitBox(TileItem.Position,TileItem.Size,"Up",true,255);
+		HighscoreCells.Add(FText::Format(FText::FromString("{0}."), FText::AsNumber(i+1)));
+		HighscoreCells.Add(FText::FromString(FPlatformerTimeFormat::Describe(HighscoreEntries[i].Time, false)));
+		HighscoreCells.Add(FText::FromString(HighscoreEntries[i].Name));
 	}
-
-	if (HighScoreName[CurrentLetter] > 'A')
-	{
-		TileItem.Position = FVector2D(DrawX+SizeX*CurrentLetter,DrawY+SizeY*2);
-		TileItem.Texture = DownButtonTexture->Resource;
-
-		AddHitBox(TileItem.Position,TileItem.Size,"Down",true,255);
-		Canvas->DrawItem(TileItem);
-	}
-
-	FCanvasTextItem TextItem(FVector2D(DrawX, DrawY), FText(), HUDFont, FLinearColor::White);
-	TextItem.Scale = FVector2D(TextScale * UIScale, TextScale * UIScale);
-	TextItem.EnableShadow( FLinearColor::Transparent );
-
-
-	float StrSizeX, StrSizeY;
-	float Offset = 0;
-
-	for (int32 i = 0; i < HighScoreName.Num(); i++)
-	{
-		TextItem.Text = FText::FromString(FString::Chr(HighScoreName[i]));
-		Canvas->StrLen(HUDFont, TextItem.Text.ToString(), StrSizeX, StrSizeY);
-		Canvas->StrLen(HUDFont, TextItem.Text.ToString(), StrSizeX, StrSizeY);
-		Canvas->StrLen(HUDFont, TextItem.Text.ToString(), StrSizeX, StrSizeY);
-		StrSizeX = StrSizeX * TextScale * UIScale;
-		StrSizeY = StrSizeY * TextScale * UIScale;
-		TextItem.Position = FVector2D(DrawX+Offset+(SizeX-StrSizeX)/2.0f, DrawY + SizeY);
-
-		DrawBorder(DrawX + Offset, DrawY + SizeY,  SizeX, SizeY, 0.4f, CurrentLetter == i ? BlueBorder : RedBorder);
-		AddHitBox(FVector2D(DrawX + Offset,DrawY + SizeY),TileItem.Size,FName(TEXT("Letter"),i),true,255);
-
-		Canvas->DrawItem( TextItem );
-		Offset += SizeX;
-	}
-
-	const float ButtonWidth = 200 * UIScale;
-	TextItem.Text = LOCTEXT("OK", "OK");
-	Canvas->StrLen(HUDFont, TextItem.Text.ToString(), StrSizeX, StrSizeY);
-	StrSizeX = StrSizeX * TextScale * UIScale;
-	StrSizeY = StrSizeY * TextScale * UIScale;
-	TextItem.Position = FVector2D((Canvas->ClipX - StrSizeX) / 2.0f, DrawY + SizeY*4);
-
-	DrawBorder((Canvas->ClipX - ButtonWidth) / 2.0f, DrawY + SizeY*4,  ButtonWidth, SizeY, 0.4f, BlueBorder);
-	AddHitBox(FVector2D((Canvas->ClipX - ButtonWidth) / 2.0f,DrawY + SizeY*4),FVector2D(ButtonWidth,SizeY),FName("OK"),true,255);
-	Canvas->DrawItem( TextItem );
 }
 
-/** draws high score */
-void APlatformerHUD::DrawHighscore()
+void APlatformerHUD::ShowHighscorePrompt()
 {
-	const FText Highscore = LOCTEXT("Highscore", "High score");
-	const float SizeX = Canvas->ClipX * 0.4f;
-	const float SizeY = 1000 * UIScale;
-	const float DrawX = (Canvas->ClipX - SizeX) / 2.0f;
-	const float DrawY = (Canvas->ClipY - SizeY) / 2.0f;
-
-	DrawBorder(DrawX, DrawY,  SizeX, SizeY, 1.0f, BlueBorder);
-
-	const float TextScale = 1.4f;
-	const float TextMargin = 0.03f;
-	float StrSizeX, StrSizeY;
-	Canvas->StrLen(HUDFont, Highscore.ToString(), StrSizeX, StrSizeY);
-	StrSizeX = StrSizeX * TextScale * UIScale;
-	StrSizeY = StrSizeY * TextScale * UIScale;
-
-	FCanvasTextItem TextItem( FVector2D( (Canvas->ClipX - StrSizeX) / 2.0f, DrawY + SizeY * TextMargin ), 
-		Highscore, HUDFont, FLinearColor::White );
-	TextItem.Scale = FVector2D( TextScale * UIScale, TextScale * UIScale );
-	TextItem.EnableShadow( FLinearColor::Transparent );
-	Canvas->DrawItem( TextItem );
-
-	const float BorderSize = BlueBorder.LeftBorder->Resource->GetSizeX() * UIScale;
-	FCanvasTileItem TileItem(FVector2D(  DrawX + BorderSize, DrawY + SizeY * TextMargin + StrSizeY ), BlueBorder.TopBorder->Resource, 
-		FVector2D( SizeX - 2* BorderSize, BlueBorder.TopBorder->Resource->GetSizeY() * UIScale ),
-		FVector2D(0,0),FVector2D((SizeX - 2* BorderSize) / BlueBorder.TopBorder->Resource->GetSizeX() * UIScale,1), FLinearColor::White);
-	TileItem.BlendMode = SE_BLEND_Translucent;
-	Canvas->DrawItem(TileItem);
-
-
-	const float StartY = DrawY + SizeY * TextMargin*3 + StrSizeY * TextScale * UIScale;
-
-	const float ColWidths[] = {70*UIScale, 340*UIScale, 200*UIScale};
-	
-	const float TotalWidth = ColWidths[0]+ColWidths[1]+ColWidths[2];
-
-	for (int32 i=0; i < 10; i++ )
+	bEnterNamePromptActive = true;
+	bNamePromptDirty = true;
+	if (PlayerOwner)
 	{
-		FText Texts[] = { FText::Format(FText::FromString("{0}."), FText::AsNumber(i+1)),
-			FText::FromString(UPlatformerBlueprintLibrary::DescribeTime(HighscoreTimes[i], false)),
-			FText::FromString(HighscoreNames[i]) };
-		float Offset = 0;
-		for (uint8 column=0; column < 3; column++)
-		{
-			TextItem.Text = Texts[column]; 
-			Canvas->StrLen(HUDFont, TextItem.Text.ToString(), StrSizeX, StrSizeY);
-			StrSizeX = StrSizeX * TextScale * UIScale;
-			StrSizeY = StrSizeY * TextScale * UIScale;
-			TextItem.Position = FVector2D((Canvas->ClipX - TotalWidth) / 2.0f + Offset + ColWidths[column] - StrSizeX, StartY + i * StrSizeY);
-			Canvas->DrawItem( TextItem );
-			Offset += ColWidths[column];
-		}
-
+		PlayerOwner->bShowMouseCursor = bEnterNamePromptActive;
 	}
-
 }
 
+void APlatformerHUD::HideHighscore()
+{
+	bHighscoreActive = false;
+}
 
 void APlatformerHUD::DrawHUD()
 {
@@ -258,22 +394,26 @@ void APlatformerHUD::DrawHUD()
 	Super::DrawHUD();
 	
 	APlatformerGameMode* MyGame = GetWorld()->GetAuthGameMode<APlatformerGameMode>();	
-	if (MyGame)
+	if (MyGame && !HUDWidget.IsValid())
+	{
+		// textures are still streaming in, messages wait in their queues until the widget exists
+		DrawFallback(MyGame);
+	}
+	else if (MyGame)
 	{
 		// active messages
-		DrawActiveMessages();
+		UpdateActiveMessages();
 
 		// round timer
 		EGameState GameState = MyGame->GetGameState();
-		if (GameState == EGameState::Playing)
-		{
-			DisplayRoundTimer();
-			DisplayRoundTimeModification();
-		}
+		UpdateRoundTimer(GameState == EGameState::Playing);
+		UpdateRoundTimeModification(GameState == EGameState::Playing);
 
 		//When game is finished, draw the summary screen when picture is shown from Blueprints
-		if (GameState == EGameState::Finished && MyGame->PlatformerPicture && MyGame->PlatformerPicture->IsVisible())
+		const bool bShowSummary = GameState == EGameState::Finished && MyGame->PlatformerPicture && MyGame->PlatformerPicture->IsVisible();
+		if (bShowSummary)
 		{
+			// frame and picture stay on the canvas, widgets are drawn above it
 			const float SizeX = Canvas->ClipX * 0.75f;
 			const float SizeY = Canvas->ClipY * 0.7f;
 			const float DrawX = (Canvas->ClipX - SizeX) / 2.0f;
@@ -282,68 +422,80 @@ void APlatformerHUD::DrawHUD()
 			DrawBorder(DrawX, DrawY,  SizeX, SizeY, 1.0f, MyGame->IsRoundWon() ? BlueBorder : RedBorder);
 
 			MyGame->PlatformerPicture->Tick(Canvas);
+		}
 
-			if (EndingMessages.Num() > 0)
-			{
-				//First message with total time
-				const float EndingMessagesScale = 1.6f;
-				const float TextMargin = 0.03f;
-				float StrSizeX, StrSizeY;
-				Canvas->StrLen(HUDFont, EndingMessages[0].Message, StrSizeX, StrSizeY);
-				StrSizeX = StrSizeX * EndingMessagesScale * UIScale;
-				StrSizeY = StrSizeY * EndingMessagesScale * UIScale;
-				
-				FCanvasTextItem TextItem( FVector2D( (Canvas->ClipX - StrSizeX) / 2.0f, DrawY + SizeY * TextMargin ), 
-					FText::FromString( EndingMessages[0].Message ), HUDFont, FLinearColor::White );
-				TextItem.Scale = FVector2D( EndingMessagesScale * UIScale, EndingMessagesScale * UIScale );
-				TextItem.EnableShadow( FLinearColor::Transparent );
-				Canvas->DrawItem( TextItem );
-				
-				//2nd message will only be shown after making at least 2 runs
-				//displays time difference + NEW RECORD! or TRY AGAIN
-				if (EndingMessages.Num() > 1)
-				{
-					Canvas->StrLen(HUDFont, EndingMessages[1].Message, StrSizeX, StrSizeY);
-					StrSizeX = StrSizeX * EndingMessagesScale * UIScale;
-					StrSizeY = StrSizeY * EndingMessagesScale * UIScale;
-					TextItem.Position = FVector2D( (Canvas->ClipX - StrSizeX) / 2.0f ,
-						DrawY + SizeY * (1.0f-TextMargin) - StrSizeY );
-					TextItem.Text =  FText::FromString( EndingMessages[1].Message );
-					Canvas->DrawItem( TextItem );
-				}
-			}
-
+		if (bShowSummary != bEndingMessagesShown || (bShowSummary && bEndingMessagesDirty))
+		{
+			HUDWidget->SetEndingMessages(bShowSummary ? EndingMessages : TArray<FPlatformerMessageData>());
+			bEndingMessagesShown = bShowSummary;
+			bEndingMessagesDirty = false;
 		}
 
 		// game state related messages, make it pulse 1 Hz
+		const FText* InputPrompt = nullptr;
 		if (GameState == EGameState::Waiting || MyGame->CanBeRestarted())
 		{
 			const int32 GameTime = FMath::TruncToInt(1.0f * GetWorld()->GetTimeSeconds());
 			const bool bShowInputMessage = (GameTime % 2) == 0;
 			if (bShowInputMessage)
 			{
-				FString InputMessage = TEXT("Jump or Slide");
+				InputPrompt = &InputMessageDefault;
 				switch (GameState)
 				{
-				case EGameState::Waiting:	InputMessage += TEXT(" to start running"); break;
-				case EGameState::Finished:	InputMessage += TEXT(" to play again"); break;
+				case EGameState::Waiting:	InputPrompt = &InputMessageWaiting; break;
+				case EGameState::Finished:	InputPrompt = &InputMessageFinished; break;
 				}
-
-				DrawMessage(InputMessage, 0.5f, 0.9f, 1.0f, FLinearColor::White);
 			}
 		}
+		if (InputPrompt != ShownInputPrompt)
+		{
+			HUDWidget->SetInputPrompt(InputPrompt);
+			ShownInputPrompt = InputPrompt;
+		}
 
-		if (GameState == EGameState::Finished)
+		const bool bShowNamePrompt = GameState == EGameState::Finished && bEnterNamePromptActive;
+		if (bShowNamePrompt && (bNamePromptDirty || !bNamePromptShown))
 		{
-			if (bEnterNamePromptActive)
-			{
-				DrawHighscoreEntryPrompt();
-			}
-			if (bHighscoreActive)
-			{
-				DrawHighscore();
-			}
+			HUDWidget->SetNamePrompt(HighScoreName, CurrentLetter);
 		}
+		else if (!bShowNamePrompt && bNamePromptShown)
+		{
+			HUDWidget->HideNamePrompt();
+		}
+		bNamePromptShown = bShowNamePrompt;
+		bNamePromptDirty = false;
+
+		const bool bShowHighscore = GameState == EGameState::Finished && bHighscoreActive;
+		if (bShowHighscore && (bHighscoreDirty || !bHighscoreShown))
+		{
+			HUDWidget->SetHighscore(HighscoreCells);
+		}
+		else if (!bShowHighscore && bHighscoreShown)
+		{
+			HUDWidget->HideHighscore();
+		}
+		bHighscoreShown = bShowHighscore;
+		bHighscoreDirty = false;
+	}
+}
+
+void APlatformerHUD::DrawFallback(APlatformerGameMode* MyGame)
+{
+	const EGameState GameState = MyGame->GetGameState();
+	if (GameState == EGameState::Playing)
+	{
+		TCHAR TimeText[FPlatformerTimeFormat::MaxLength];
+		FPlatformerTimeFormat::Format(MyGame->GetRoundDuration(), false, TimeText, ARRAY_COUNT(TimeText));
+
+		FCanvasTextItem TextItem(FVector2D(Canvas->ClipX * 0.5f, Canvas->ClipY * 0.1f), FText::FromString(TimeText), GEngine->GetLargeFont(), FLinearColor::White);
+		TextItem.bCentreX = true;
+		TextItem.bCentreY = true;
+		TextItem.Scale = FVector2D(2.0f * UIScale, 2.0f * UIScale);
+		Canvas->DrawItem(TextItem);
+	}
+	else if (GameState == EGameState::Finished && MyGame->PlatformerPicture && MyGame->PlatformerPicture->IsVisible())
+	{
+		MyGame->PlatformerPicture->Tick(Canvas);
 	}
 }
 
@@ -353,52 +505,42 @@ void APlatformerHUD::NotifyRoundTimeModified(float DeltaTime)
 	RoundTimeModificationTime = GetWorld()->GetTimeSeconds();
 }
 
-void APlatformerHUD::DisplayRoundTimeModification()
+void APlatformerHUD::UpdateRoundTimeModification(bool bVisible)
 {
 	const float ModificationDisplayDuration = 0.5f;
 	const float CurrTime = GetWorld()->GetTimeSeconds();
-	if (RoundTimeModification != 0.0f &&
+	if (bVisible && RoundTimeModification != 0.0f &&
 		CurrTime - RoundTimeModificationTime <= ModificationDisplayDuration)
 	{
-		FString DisplayText = UPlatformerBlueprintLibrary::DescribeTime(RoundTimeModification, true);
-
 		const float Delta = FMath::Clamp((CurrTime - RoundTimeModificationTime) / ModificationDisplayDuration, 0.0f, 1.0f);
 		const float PosY = 0.11f + Delta * 0.24f;
 
-		DrawMessage(DisplayText, 0.5f, PosY, 1.0f, FLinearColor::White);
+		HUDWidget->SetRoundTimeModification(true, RoundTimeModification, PosY);
+	}
+	else
+	{
+		HUDWidget->SetRoundTimeModification(false);
 	}
 }
 
-void APlatformerHUD::DisplayRoundTimer()
+void APlatformerHUD::UpdateRoundTimer(bool bVisible)
 {
 	APlatformerGameMode* GI = GetWorld()->GetAuthGameMode<APlatformerGameMode>();	
-	if (GI)
+	if (GI && bVisible)
 	{
-		const float RoundDuration = GI->GetRoundDuration();
-		const bool bIncludeSign = false;
-		FString RoundDurationText = FString(TEXT("Time: ")) + UPlatformerBlueprintLibrary::DescribeTime(RoundDuration, bIncludeSign);
-
-		DrawMessage(RoundDurationText, 0.5f, 0.1f, 1.0f, FLinearColor::White);
+		// the timer repaints the HUD, so it may be refreshed less often when frame time is short
+		const float CurrTime = GetWorld()->GetRealTimeSeconds();
+		if (RoundTimerUpdateTime < 0.0f || CurrTime - RoundTimerUpdateTime >= CVarHUDTimerInterval.GetValueOnGameThread() || !GI->IsRoundInProgress())
+		{
+			// formatted in place by the widget, nothing is allocated per frame
+			HUDWidget->SetRoundTimer(true, GI->GetRoundDuration());
+			RoundTimerUpdateTime = CurrTime;
+		}
 	}
-}
-
-void APlatformerHUD::DrawMessage(FString Message, float PosX, float PosY, float TextScale, FLinearColor TextColor, bool bRedBorder)
-{
-	if (Canvas)
+	else
 	{
-		float SizeX, SizeY;
-		Canvas->StrLen(HUDFont, Message, SizeX, SizeY);
-
-		const float DrawX = Canvas->ClipX * FMath::Clamp(PosX, 0.0f, 1.0f) - (SizeX * TextScale * 0.5f * UIScale);
-		const float DrawY = Canvas->ClipY * FMath::Clamp(PosY, 0.0f, 1.0f) - (SizeY * TextScale * 0.5f * UIScale);
-		const float BoxPadding = 8.0f * UIScale;
-
-		DrawBorder(DrawX - BoxPadding, DrawY - BoxPadding,  (SizeX * TextScale * UIScale) + (BoxPadding * 2.0f), (SizeY * TextScale * UIScale) + (BoxPadding * 2.0f), 0.4f, bRedBorder ? RedBorder : BlueBorder);
-
-		FCanvasTextItem TextItem( FVector2D( DrawX, DrawY ), FText::FromString( Message ), HUDFont, TextColor );
-		TextItem.Scale = FVector2D( TextScale*UIScale, TextScale*UIScale );
-		TextItem.EnableShadow( FLinearColor::Transparent );
-		Canvas->DrawItem( TextItem );
+		HUDWidget->SetRoundTimer(false);
+		RoundTimerUpdateTime = -1.0f;
 	}
 }
 
@@ -414,7 +556,7 @@ void APlatformerHUD::DrawBorder(float PosX, float PosY, float Width, float Heigh
 	Canvas->DrawItem(BorderItem);
 }
 
-void APlatformerHUD::AddMessage(FString Message, float DisplayDuration, float PosX, float PosY, float TextScale, bool bRedBorder)
+void APlatformerHUD::AddMessage(const FString& Message, float DisplayDuration, float PosX, float PosY, float TextScale, bool bRedBorder)
 {
 	APlatformerGameMode* MyGame = GetWorld()->GetAuthGameMode<APlatformerGameMode>();	
 
@@ -422,7 +564,6 @@ void APlatformerHUD::AddMessage(FString Message, float DisplayDuration, float Po
 	{
 		FPlatformerMessageData MsgData;
 
-		MsgData.Message = Message;
 		MsgData.DisplayDuration = DisplayDuration;
 		MsgData.DisplayStartTime = GetWorld()->GetTimeSeconds();
 		MsgData.PosX = PosX;
@@ -434,35 +575,40 @@ void APlatformerHUD::AddMessage(FString Message, float DisplayDuration, float Po
 
 		if (GameState == EGameState::Finished)
 		{
-			EndingMessages.Add(MsgData);
+			MsgData.Message = Message;
+			EndingMessages.Add(MoveTemp(MsgData));
+			bEndingMessagesDirty = true;
 		}
 		else
 		{
 			if (EndingMessages.Num() > 0)
 			{
-				EndingMessages.Empty();
+				// keep the storage for the next summary
+				EndingMessages.Reset();
+				bEndingMessagesDirty = true;
+			}
+			// the queue copies Message into a reused slot
+			if (ActiveMessages.Add(Message, MsgData))
+			{
+				bMessagesDirty = true;
 			}
-			ActiveMessages.Add(MsgData);
 		}
 	}
 	
 }
 
-void APlatformerHUD::DrawActiveMessages()
+void APlatformerHUD::UpdateActiveMessages()
 {
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	for (int32 i = ActiveMessages.Num() - 1; i >= 0; --i)
+	// messages are sorted by expiry, so this only looks at the ones that expired
+	if (ActiveMessages.RemoveExpired(GetWorld()->GetTimeSeconds()) > 0)
 	{
-		const FPlatformerMessageData& Message = ActiveMessages[i];
-		const bool bIsActive = (CurrTime < Message.DisplayDuration + Message.DisplayStartTime);
-		if (bIsActive)
-		{
-			DrawMessage(Message.Message, Message.PosX, Message.PosY, Message.TextScale, FLinearColor::White, Message.bRedBorder);
-		}
-		else
-		{
-			ActiveMessages.RemoveAt(i);
-		}
+		bMessagesDirty = true;
+	}
+
+	if (bMessagesDirty)
+	{
+		HUDWidget->SetMessages(ActiveMessages);
+		bMessagesDirty = false;
 	}
 }
 
@@ -0,0 +1,16 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerStringUtils.h"
+
+void FPlatformerStringUtils::AssignInPlace(FString& Dest, const FString& Source)
+{
+	// character arrays include the terminator, empty strings have no characters at all
+	TArray<TCHAR>& DestChars = Dest.GetCharArray();
+	const TArray<TCHAR>& SourceChars = Source.GetCharArray();
+	DestChars.SetNumUninitialized(SourceChars.Num(), false);
+	if (SourceChars.Num() > 0)
+	{
+		FMemory::Memcpy(DestChars.GetData(), SourceChars.GetData(), SourceChars.Num() * sizeof(TCHAR));
+	}
+}
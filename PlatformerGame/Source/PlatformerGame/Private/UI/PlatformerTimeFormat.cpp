@@ -0,0 +1,41 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "PlatformerTimeFormat.h"
+
+int32 FPlatformerTimeFormat::Format(float TimeSeconds, bool bShowSign, TCHAR* Buffer, int32 BufferSize)
+{
+	check(BufferSize >= MaxLength);
+
+	// computed in double and truncated, like the script version this replaces
+	const double AbsTimeSeconds = FMath::Abs((double)TimeSeconds);
+	const int32 TotalSeconds = (int32)AbsTimeSeconds % 3600;
+	const int32 NumMinutes = TotalSeconds / 60;
+	const int32 NumSeconds = TotalSeconds % 60;
+	const int32 NumMiliSeconds = (int32)((int64)(AbsTimeSeconds * 1000.0) % 1000);
+
+	int32 Length = 0;
+	if (bShowSign)
+	{
+		Buffer[Length++] = TimeSeconds < 0.0f ? TEXT('-') : TEXT('+');
+	}
+	Buffer[Length++] = TEXT('0') + NumMinutes / 10;
+	Buffer[Length++] = TEXT('0') + NumMinutes % 10;
+	Buffer[Length++] = TEXT(':');
+	Buffer[Length++] = TEXT('0') + NumSeconds / 10;
+	Buffer[Length++] = TEXT('0') + NumSeconds % 10;
+	Buffer[Length++] = TEXT('.');
+	Buffer[Length++] = TEXT('0') + NumMiliSeconds / 100;
+	Buffer[Length++] = TEXT('0') + (NumMiliSeconds / 10) % 10;
+	Buffer[Length++] = TEXT('0') + NumMiliSeconds % 10;
+	Buffer[Length] = 0;
+
+	return Length;
+}
+
+FString FPlatformerTimeFormat::Describe(float TimeSeconds, bool bShowSign)
+{
+	TCHAR Buffer[MaxLength];
+	const int32 Length = Format(TimeSeconds, bShowSign, Buffer, ARRAY_COUNT(Buffer));
+	return FString(Length, Buffer);
+}
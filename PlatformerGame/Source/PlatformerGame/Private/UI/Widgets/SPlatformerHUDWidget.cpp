@@ -0,0 +1,621 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGame.h"
+#include "SPlatformerHUDWidget.h"
+#include "PlatformerTimeFormat.h"
+#include "PlatformerStringUtils.h"
+#include "SInvalidationPanel.h"
+#include "SDPIScaler.h"
+
+#define LOCTEXT_NAMESPACE "PlatformerGame.HUD"
+
+/** width of the layout, before scaling to the viewport */
+static const float HUDLayoutWidth = 2048.0f;
+
+/** padding between frame border and its content */
+static const float FramePadding = 8.0f;
+
+void SPlatformerHUDCanvas::Construct(const FArguments& InArgs)
+{
+}
+
+SPlatformerHUDCanvas::FSlot& SPlatformerHUDCanvas::AddSlot(int32 InGroup, const FVector2D& InAnchor, const FVector2D& InAlignment)
+{
+	FSlot* NewSlot = new FSlot();
+	NewSlot->Anchor = InAnchor;
+	NewSlot->Alignment = InAlignment;
+	NewSlot->Group = InGroup;
+
+	// keep children sorted by group, OnPaint starts new layers whenever the group changes
+	int32 InsertIndex = Children.Num();
+	while (InsertIndex > 0 && Children[InsertIndex - 1].Group > InGroup)
+	{
+		--InsertIndex;
+	}
+	Children.Insert(NewSlot, InsertIndex);
+	return *NewSlot;
+}
+
+void SPlatformerHUDCanvas::ClearChildren(int32 Group)
+{
+	for (int32 ChildIndex = Children.Num() - 1; ChildIndex >= 0; --ChildIndex)
+	{
+		if (Children[ChildIndex].Group == Group)
+		{
+			Children.RemoveAt(ChildIndex);
+		}
+	}
+}
+
+int32 SPlatformerHUDCanvas::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	FArrangedChildren ArrangedChildren(EVisibility::Visible);
+	ArrangeChildren(AllottedGeometry, ArrangedChildren);
+
+	const bool bForwardedEnabled = ShouldBeEnabled(bParentEnabled);
+	int32 MaxLayerId = LayerId;
+	int32 GroupLayerId = LayerId;
+	int32 ChildIndex = 0;
+	int32 PrevGroup = INDEX_NONE;
+	for (int32 ArrangedIndex = 0; ArrangedIndex < ArrangedChildren.Num(); ++ArrangedIndex)
+	{
+		const FArrangedWidget& CurWidget = ArrangedChildren[ArrangedIndex];
+
+		// arranged children keep the order of Children, skipping hidden ones
+		while (Children[ChildIndex].GetWidget() != CurWidget.Widget)
+		{
+			++ChildIndex;
+		}
+
+		// children of one group share their layers, the next group starts above everything painted so far
+		const int32 Group = Children[ChildIndex].Group;
+		if (ArrangedIndex > 0 && Group != PrevGroup)
+		{
+			GroupLayerId = MaxLayerId + 1;
+		}
+		PrevGroup = Group;
+
+		const FSlateRect ChildClipRect = MyClippingRect.IntersectionWith(CurWidget.Geometry.GetClippingRect());
+		const int32 ChildMaxLayerId = CurWidget.Widget->Paint(Args.WithNewParent(this), CurWidget.Geometry, ChildClipRect, OutDrawElements, GroupLayerId, InWidgetStyle, bForwardedEnabled);
+		MaxLayerId = FMath::Max(MaxLayerId, ChildMaxLayerId);
+	}
+	return MaxLayerId;
+}
+
+void SPlatformerHUDCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const
+{
+	for (int32 ChildIndex = 0; ChildIndex < Children.Num(); ++ChildIndex)
+	{
+		const FSlot& Slot = Children[ChildIndex];
+		const TSharedRef<SWidget>& Widget = Slot.GetWidget();
+		if (ArrangedChildren.Accepts(Widget->GetVisibility()))
+		{
+			const FVector2D Size = Widget->GetDesiredSize();
+			const FVector2D Offset = AllottedGeometry.Size * Slot.Anchor - Size * Slot.Alignment;
+			ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(Widget, Offset, Size));
+		}
+	}
+}
+
+FVector2D SPlatformerHUDCanvas::ComputeDesiredSize(float) const
+{
+	// children are placed relative to whatever size the canvas is given
+	return FVector2D::ZeroVector;
+}
+
+FChildren* SPlatformerHUDCanvas::GetChildren()
+{
+	return &Children;
+}
+
+void SPlatformerHUDText::Construct(const FArguments& InArgs)
+{
+	Text = InArgs._Text;
+	Font = InArgs._Font;
+}
+
+void SPlatformerHUDText::SetText(const FString& InText)
+{
+	FPlatformerStringUtils::AssignInPlace(Text, InText);
+}
+
+void SPlatformerHUDText::SetFontSize(int32 Size)
+{
+	Font.Size = Size;
+}
+
+int32 SPlatformerHUDText::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	FSlateDrawElement::MakeText(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Text, Font, MyClippingRect,
+		ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect, InWidgetStyle.GetColorAndOpacityTint());
+	return LayerId;
+}
+
+FVector2D SPlatformerHUDText::ComputeDesiredSize(float) const
+{
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	return FontMeasure->Measure(Text, Font);
+}
+
+void SPlatformerHUDTimeText::Construct(const FArguments& InArgs)
+{
+	bShowSign = InArgs._bShowSign;
+	Font = InArgs._Font;
+
+	Text = InArgs._Prefix;
+	PrefixLength = Text.Len();
+	Text.Reserve(PrefixLength + FPlatformerTimeFormat::MaxLength);
+	SetTime(0.0f);
+}
+
+void SPlatformerHUDTimeText::SetTime(float TimeSeconds)
+{
+	TCHAR Buffer[FPlatformerTimeFormat::MaxLength];
+	const int32 Length = FPlatformerTimeFormat::Format(TimeSeconds, bShowSign, Buffer, ARRAY_COUNT(Buffer));
+
+	// overwrite the time after the prefix, capacity was reserved in Construct
+	TArray<TCHAR>& Chars = Text.GetCharArray();
+	Chars.SetNumUninitialized(PrefixLength + Length + 1, false);
+	FMemory::Memcpy(Chars.GetData() + PrefixLength, Buffer, (Length + 1) * sizeof(TCHAR));
+}
+
+void SPlatformerHUDWidget::Construct(const FArguments& InArgs)
+{
+	OwnerHUD = InArgs._OwnerHUD;
+	MakeFrameBrushes(*InArgs._BlueBorder, BlueBrushes);
+	MakeFrameBrushes(*InArgs._RedBorder, RedBrushes);
+
+	// only the top left 90x90 pixels of button textures are used
+	const float ButtonUVL = 90.0f/128.0f;
+	UpButtonBrush.SetResourceObject(InArgs._UpButtonTexture);
+	UpButtonBrush.ImageSize = FVector2D(90.0f, 90.0f);
+	UpButtonBrush.SetUVRegion(FBox2D(FVector2D::ZeroVector, FVector2D(ButtonUVL, ButtonUVL)));
+	DownButtonBrush = UpButtonBrush;
+	DownButtonBrush.SetResourceObject(InArgs._DownButtonTexture);
+
+	TSharedPtr<SPlatformerHUDCanvas> RoundTimerCanvas;
+
+	ChildSlot
+	[
+		SNew(SDPIScaler)
+		.DPIScale(InArgs._UIScale)
+		[
+			SNew(SOverlay)
+			+SOverlay::Slot()
+			[
+				SAssignNew(CachedPanel, SInvalidationPanel)
+				[
+					SAssignNew(FramesCanvas, SPlatformerHUDCanvas)
+				]
+			]
+			// round timer changes every frame while playing, caching it would only cost
+			+SOverlay::Slot()
+			[
+				SAssignNew(RoundTimerCanvas, SPlatformerHUDCanvas)
+			]
+		]
+	];
+
+	RoundTimerFrame = MakeFrame(SAssignNew(RoundTimerText, SPlatformerHUDTimeText).Prefix(TEXT("Time: ")).Font(GetFont(1.0f)), false, true);
+	RoundTimerFrame->SetVisibility(EVisibility::Collapsed);
+	RoundTimerCanvas->AddSlot(0, FVector2D(0.5f, 0.1f))
+	[
+		RoundTimerFrame.ToSharedRef()
+	];
+
+	RoundTimeModificationFrame = MakeFrame(SAssignNew(RoundTimeModificationText, SPlatformerHUDTimeText).bShowSign(true).Font(GetFont(1.0f)), false, true);
+	RoundTimeModificationFrame->SetVisibility(EVisibility::Collapsed);
+	RoundTimeModificationSlot = &RoundTimerCanvas->AddSlot(0, FVector2D(0.5f, 0.11f))
+	[
+		RoundTimeModificationFrame.ToSharedRef()
+	];
+
+	// message frames are built once, SetMessages only changes their text, theme, position and visibility
+	const FSlateFontInfo MessageFont = GetFont(1.0f);
+	for (int32 i = 0; i < ARRAY_COUNT(MessageFrames); i++)
+	{
+		FMessageFrame& Frame = MessageFrames[i];
+		Frame.Widget = SAssignNew(Frame.Background, SBorder)
+			.BorderImage(&BlueBrushes.Background)
+			.Padding(0.0f)
+			.Visibility(EVisibility::Collapsed)
+			[
+				SAssignNew(Frame.Border, SBorder)
+				.BorderImage(&BlueBrushes.SmallBorder)
+				.Padding(FramePadding)
+				.HAlign(HAlign_Center)
+				.VAlign(VAlign_Center)
+				[
+					SAssignNew(Frame.Text, SPlatformerHUDText)
+					.Font(MessageFont)
+				]
+			];
+		Frame.Slot = &FramesCanvas->AddSlot(Group_Messages, FVector2D(0.5f, 0.5f))
+		[
+			Frame.Widget.ToSharedRef()
+		];
+	}
+}
+
+void SPlatformerHUDWidget::MakeFrameBrushes(const FBorderTextures& BorderTextures, FFrameBrushes& FrameBrushes)
+{
+	FrameBrushes.Background.SetResourceObject(BorderTextures.Background);
+	FrameBrushes.Background.ImageSize = FVector2D(BorderTextures.Background->GetSurfaceWidth(), BorderTextures.Background->GetSurfaceHeight());
+	FrameBrushes.Background.DrawAs = ESlateBrushDrawType::Image;
+	FrameBrushes.Background.Tiling = ESlateBrushTileType::Both;
+
+	FrameBrushes.Border.SetResourceObject(BorderTextures.Border);
+	FrameBrushes.Border.ImageSize = FVector2D(BorderTextures.Border->GetSurfaceWidth(), BorderTextures.Border->GetSurfaceHeight());
+	FrameBrushes.Border.DrawAs = ESlateBrushDrawType::Border;
+	FrameBrushes.Border.Margin = FMargin(85.0f/256.0f, 95.0f/256.0f);
+
+	FrameBrushes.SmallBorder = FrameBrushes.Border;
+	FrameBrushes.SmallBorder.ImageSize *= 0.4f;
+
+	FrameBrushes.Separator.SetResourceObject(BorderTextures.TopBorder);
+	FrameBrushes.Separator.ImageSize = FVector2D(BorderTextures.TopBorder->GetSurfaceWidth(), BorderTextures.TopBorder->GetSurfaceHeight());
+	FrameBrushes.Separator.DrawAs = ESlateBrushDrawType::Image;
+	FrameBrushes.Separator.Tiling = ESlateBrushTileType::Horizontal;
+}
+
+FSlateFontInfo SPlatformerHUDWidget::GetFont(float TextScale)
+{
+	// same face as the RobotoLight48 canvas font
+	return FSlateFontInfo(FPaths::GameContentDir() / TEXT("Slate/Fonts/Roboto-Light.ttf"), GetFontSize(TextScale));
+}
+
+int32 SPlatformerHUDWidget::GetFontSize(float TextScale)
+{
+	// 36pt is 48px
+	return FMath::Max(1, FMath::RoundToInt(36.0f * TextScale));
+}
+
+TSharedRef<SWidget> SPlatformerHUDWidget::MakeFrame(TSharedRef<SWidget> Content, bool bRedBorder, bool bSmallBorder) const
+{
+	const FFrameBrushes& Brushes = bRedBorder ? RedBrushes : BlueBrushes;
+	return SNew(SBorder)
+		.BorderImage(&Brushes.Background)
+		.Padding(0.0f)
+		[
+			SNew(SBorder)
+			.BorderImage(bSmallBorder ? &Brushes.SmallBorder : &Brushes.Border)
+			.Padding(FramePadding)
+			.HAlign(HAlign_Center)
+			.VAlign(VAlign_Center)
+			[
+				Content
+			]
+		];
+}
+
+TSharedRef<STextBlock> SPlatformerHUDWidget::MakeText(const FText& Text, float TextScale) const
+{
+	return SNew(STextBlock)
+		.Text(Text)
+		.Font(GetFont(TextScale))
+		.ColorAndOpacity(FLinearColor::White);
+}
+
+void SPlatformerHUDWidget::InvalidateCache()
+{
+	CachedPanel->InvalidateCache();
+}
+
+void SPlatformerHUDWidget::SetRoundTimer(bool bVisible, float TimeSeconds)
+{
+	const EVisibility Visibility = bVisible ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+	if (RoundTimerFrame->GetVisibility() != Visibility)
+	{
+		RoundTimerFrame->SetVisibility(Visibility);
+	}
+	if (bVisible)
+	{
+		RoundTimerText->SetTime(TimeSeconds);
+	}
+}
+
+void SPlatformerHUDWidget::SetRoundTimeModification(bool bVisible, float TimeSeconds, float PosY)
+{
+	const EVisibility Visibility = bVisible ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+	if (RoundTimeModificationFrame->GetVisibility() != Visibility)
+	{
+		RoundTimeModificationFrame->SetVisibility(Visibility);
+	}
+	if (bVisible)
+	{
+		RoundTimeModificationText->SetTime(TimeSeconds);
+		RoundTimeModificationSlot->Anchor.Y = PosY;
+	}
+}
+
+void SPlatformerHUDWidget::SetMessages(const FPlatformerMessageQueue& Messages)
+{
+	for (int32 i = 0; i < ARRAY_COUNT(MessageFrames); i++)
+	{
+		FMessageFrame& Frame = MessageFrames[i];
+		if (i >= Messages.Num())
+		{
+			Frame.Widget->SetVisibility(EVisibility::Collapsed);
+			continue;
+		}
+
+		const FPlatformerMessageData& Message = Messages[i];
+		const FFrameBrushes& Brushes = Message.bRedBorder ? RedBrushes : BlueBrushes;
+		Frame.Background->SetBorderImage(&Brushes.Background);
+		Frame.Border->SetBorderImage(&Brushes.SmallBorder);
+		Frame.Text->SetText(Message.Message);
+		Frame.Text->SetFontSize(GetFontSize(Message.TextScale));
+		Frame.Slot->Anchor = FVector2D(FMath::Clamp(Message.PosX, 0.0f, 1.0f), FMath::Clamp(Message.PosY, 0.0f, 1.0f));
+		Frame.Widget->SetVisibility(EVisibility::HitTestInvisible);
+	}
+	InvalidateCache();
+}
+
+void SPlatformerHUDWidget::SetEndingMessages(const TArray<FPlatformerMessageData>& Messages)
+{
+	// summary frame covers 70% of the screen height, messages keep 3% of it as margin
+	const float EndingMessagesScale = 1.6f;
+	const float FrameTop = 0.15f + 0.7f * 0.03f;
+	const float FrameBottom = 0.85f - 0.7f * 0.03f;
+
+	FramesCanvas->ClearChildren(Group_EndingMessages);
+	if (Messages.Num() > 0)
+	{
+		//First message with total time
+		FramesCanvas->AddSlot(Group_EndingMessages, FVector2D(0.5f, FrameTop), FVector2D(0.5f, 0.0f))
+		[
+			SNew(SPlatformerHUDText)
+			.Text(Messages[0].Message)
+			.Font(GetFont(EndingMessagesScale))
+		];
+	}
+	if (Messages.Num() > 1)
+	{
+		//2nd message will only be shown after making at least 2 runs
+		//displays time difference + NEW RECORD! or TRY AGAIN
+		FramesCanvas->AddSlot(Group_EndingMessages, FVector2D(0.5f, FrameBottom), FVector2D(0.5f, 1.0f))
+		[
+			SNew(SPlatformerHUDText)
+			.Text(Messages[1].Message)
+			.Font(GetFont(EndingMessagesScale))
+		];
+	}
+	InvalidateCache();
+}
+
+void SPlatformerHUDWidget::SetInputPrompt(const FText* Text)
+{
+	FramesCanvas->ClearChildren(Group_InputPrompt);
+	if (Text)
+	{
+		FramesCanvas->AddSlot(Group_InputPrompt, FVector2D(0.5f, 0.9f))
+		[
+			MakeFrame(MakeText(*Text, 1.0f), false, true)
+		];
+	}
+	InvalidateCache();
+}
+
+void SPlatformerHUDWidget::SetHighscore(const TArray<FText>& Cells)
+{
+	const float TextScale = 1.4f;
+	const float SizeX = HUDLayoutWidth * 0.4f;
+	const float SizeY = 1000.0f;
+	const float TextMargin = 0.03f;
+	const float ColWidths[] = {70.0f, 340.0f, 200.0f};
+	const float SeparatorInset = BlueBrushes.Border.ImageSize.X * BlueBrushes.Border.Margin.Left;
+
+	TSharedRef<SVerticalBox> Rows = SNew(SVerticalBox);
+	for (int32 FirstCell = 0; FirstCell + 2 < Cells.Num() && FirstCell < 30; FirstCell += 3)
+	{
+		TSharedRef<SHorizontalBox> Row = SNew(SHorizontalBox);
+		for (int32 Column = 0; Column < 3; Column++)
+		{
+			Row->AddSlot()
+			.AutoWidth()
+			[
+				SNew(SBox)
+				.WidthOverride(ColWidths[Column])
+				.HAlign(HAlign_Right)
+				[
+					MakeText(Cells[FirstCell + Column], TextScale)
+				]
+			];
+		}
+		Rows->AddSlot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		[
+			Row
+		];
+	}
+
+	FramesCanvas->ClearChildren(Group_Highscore);
+	FramesCanvas->AddSlot(Group_Highscore, FVector2D(0.5f, 0.5f))
+	[
+		SNew(SBox)
+		.WidthOverride(SizeX)
+		.HeightOverride(SizeY)
+		[
+			SNew(SBorder)
+			.BorderImage(&BlueBrushes.Background)
+			.Padding(0.0f)
+			[
+				SNew(SBorder)
+				.BorderImage(&BlueBrushes.Border)
+				.Padding(0.0f)
+				[
+					SNew(SVerticalBox)
+					+SVerticalBox::Slot()
+					.AutoHeight()
+					.HAlign(HAlign_Center)
+					.Padding(0.0f, SizeY * TextMargin, 0.0f, 0.0f)
+					[
+						MakeText(LOCTEXT("Highscore", "High score"), TextScale)
+					]
+					+SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(SeparatorInset, 0.0f)
+					[
+						SNew(SImage)
+						.Image(&BlueBrushes.Separator)
+					]
+					+SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(0.0f, SizeY * TextMargin * 2.0f, 0.0f, 0.0f)
+					[
+						Rows
+					]
+				]
+			]
+		]
+	];
+	InvalidateCache();
+}
+
+void SPlatformerHUDWidget::HideHighscore()
+{
+	FramesCanvas->ClearChildren(Group_Highscore);
+	InvalidateCache();
+}
+
+void SPlatformerHUDWidget::SetNamePrompt(const TArray<char>& Name, int32 CurrentLetter)
+{
+	const float CellSize = 90.0f;
+	const float TextScale = 1.8f;
+	const float ButtonWidth = 200.0f;
+
+	TSharedRef<SHorizontalBox> UpRow = SNew(SHorizontalBox);
+	TSharedRef<SHorizontalBox> LetterRow = SNew(SHorizontalBox);
+	TSharedRef<SHorizontalBox> DownRow = SNew(SHorizontalBox);
+	for (int32 i = 0; i < Name.Num(); i++)
+	{
+		const bool bCurrent = (i == CurrentLetter);
+
+		TSharedRef<SWidget> UpButton = SNullWidget::NullWidget;
+		if (bCurrent && Name[i] < 'Z')
+		{
+			UpButton = SNew(SButton)
+				.ButtonStyle(FCoreStyle::Get(), "NoBorder")
+				.ContentPadding(0.0f)
+				.OnClicked(this, &SPlatformerHUDWidget::OnNamePromptClicked, FName(TEXT("Up")))
+				[
+					SNew(SImage)
+					.Image(&UpButtonBrush)
+				];
+		}
+
+		TSharedRef<SWidget> DownButton = SNullWidget::NullWidget;
+		if (bCurrent && Name[i] > 'A')
+		{
+			DownButton = SNew(SButton)
+				.ButtonStyle(FCoreStyle::Get(), "NoBorder")
+				.ContentPadding(0.0f)
+				.OnClicked(this, &SPlatformerHUDWidget::OnNamePromptClicked, FName(TEXT("Down")))
+				[
+					SNew(SImage)
+					.Image(&DownButtonBrush)
+				];
+		}
+
+		UpRow->AddSlot()
+		.AutoWidth()
+		[
+			SNew(SBox)
+			.WidthOverride(CellSize)
+			.HeightOverride(CellSize)
+			[
+				UpButton
+			]
+		];
+
+		LetterRow->AddSlot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.ButtonStyle(FCoreStyle::Get(), "NoBorder")
+			.ContentPadding(0.0f)
+			.OnClicked(this, &SPlatformerHUDWidget::OnNamePromptClicked, FName(TEXT("Letter"), i))
+			[
+				SNew(SBox)
+				.WidthOverride(CellSize)
+				.HeightOverride(CellSize)
+				[
+					MakeFrame(MakeText(FText::FromString(FString::Chr(Name[i])), TextScale), !bCurrent, true)
+				]
+			]
+		];
+
+		DownRow->AddSlot()
+		.AutoWidth()
+		[
+			SNew(SBox)
+			.WidthOverride(CellSize)
+			.HeightOverride(CellSize)
+			[
+				DownButton
+			]
+		];
+	}
+
+	FramesCanvas->ClearChildren(Group_NamePrompt);
+	// letters row is centered on screen, like the canvas prompt was
+	FramesCanvas->AddSlot(Group_NamePrompt, FVector2D(0.5f, 0.5f), FVector2D(0.5f, 1.5f / 5.0f))
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		[
+			UpRow
+		]
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		[
+			LetterRow
+		]
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		[
+			DownRow
+		]
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		.Padding(0.0f, CellSize, 0.0f, 0.0f)
+		[
+			SNew(SButton)
+			.ButtonStyle(FCoreStyle::Get(), "NoBorder")
+			.ContentPadding(0.0f)
+			.OnClicked(this, &SPlatformerHUDWidget::OnNamePromptClicked, FName(TEXT("OK")))
+			[
+				SNew(SBox)
+				.WidthOverride(ButtonWidth)
+				.HeightOverride(CellSize)
+				[
+					MakeFrame(MakeText(LOCTEXT("OK", "OK"), TextScale), false, true)
+				]
+			]
+		]
+	];
+	InvalidateCache();
+}
+
+void SPlatformerHUDWidget::HideNamePrompt()
+{
+	FramesCanvas->ClearChildren(Group_NamePrompt);
+	InvalidateCache();
+}
+
+FReply SPlatformerHUDWidget::OnNamePromptClicked(FName BoxName)
+{
+	if (OwnerHUD.IsValid())
+	{
+		OwnerHUD->NotifyHitBoxClick(BoxName);
+	}
+	return FReply::Handled();
+}
+
+#undef LOCTEXT_NAMESPACE
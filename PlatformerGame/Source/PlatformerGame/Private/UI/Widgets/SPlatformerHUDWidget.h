@@ -0,0 +1,293 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "SlateBasics.h"
+#include "PlatformerHUD.h"
+
+/**
+ * Panel placing each child at a fraction of its own size, like the HUD used to place canvas messages.
+ * Children are tagged with a group so parts of the HUD can be replaced separately. Unlike SCanvas, all children
+ * of a group are painted from the same layer, so same-textured frames of the group end up in one Slate batch,
+ * while every group gets its own layers above the previous one so overlapping groups still stack.
+ */
+class SPlatformerHUDCanvas : public SPanel
+{
+public:
+	class FSlot : public TSlotBase<FSlot>
+	{
+	public:
+		/** position of the slot as a fraction of the panel size <0, 1> */
+		FVector2D Anchor;
+
+		/** point of the child placed at Anchor, as a fraction of its desired size (0.5, 0.5 centers it) */
+		FVector2D Alignment;
+
+		/** group the child was added to */
+		int32 Group;
+
+		FSlot()
+			: TSlotBase<FSlot>()
+			, Anchor(0.5f, 0.5f)
+			, Alignment(0.5f, 0.5f)
+			, Group(0)
+		{
+		}
+	};
+
+	SLATE_BEGIN_ARGS(SPlatformerHUDCanvas) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** adds a slot to InGroup, placed at InAnchor, aligned by InAlignment */
+	FSlot& AddSlot(int32 InGroup, const FVector2D& InAnchor, const FVector2D& InAlignment = FVector2D(0.5f, 0.5f));
+
+	/** removes all children of Group */
+	void ClearChildren(int32 Group);
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual void OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const override;
+	virtual FVector2D ComputeDesiredSize(float) const override;
+	virtual FChildren* GetChildren() override;
+	// End of SWidget interface
+
+private:
+	/** placed children, sorted by group */
+	TPanelChildren<FSlot> Children;
+};
+
+/** Text drawn straight from its own string, replaced in place so updating it doesn't build FText or allocate */
+class SPlatformerHUDText : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPlatformerHUDText) {}
+		/** displayed text */
+		SLATE_ARGUMENT(FString, Text)
+
+		/** font of the text */
+		SLATE_ARGUMENT(FSlateFontInfo, Font)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** replaces displayed text, reusing the storage of the previous one */
+	void SetText(const FString& InText);
+
+	/** changes size of the font, keeping its face */
+	void SetFontSize(int32 Size);
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float) const override;
+	// End of SWidget interface
+
+protected:
+	/** displayed text */
+	FString Text;
+
+	/** font of the text */
+	FSlateFontInfo Font;
+};
+
+/** Time in mm:ss.sss after a fixed prefix, formatted in place so updating it every frame doesn't allocate */
+class SPlatformerHUDTimeText : public SPlatformerHUDText
+{
+public:
+	SLATE_BEGIN_ARGS(SPlatformerHUDTimeText)
+		: _bShowSign(false)
+	{}
+		/** text shown before the time */
+		SLATE_ARGUMENT(FString, Prefix)
+
+		/** if + or - should be shown before the time */
+		SLATE_ARGUMENT(bool, bShowSign)
+
+		/** font of the text */
+		SLATE_ARGUMENT(FSlateFontInfo, Font)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** formats TimeSeconds into the displayed text */
+	void SetTime(float TimeSeconds);
+
+private:
+	/** length of the prefix in Text, which is allocated once in Construct */
+	int32 PrefixLength;
+
+	/** if + or - should be shown before the time */
+	bool bShowSign;
+};
+
+/**
+ * Retained HUD widgets. Everything but the round timer lives in an invalidation panel and is only rebuilt
+ * when APlatformerHUD pushes new data, so static frames cost no layout or text work.
+ * Layout is done for a 2048 pixel wide screen and scaled by UIScale.
+ */
+class SPlatformerHUDWidget : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPlatformerHUDWidget)
+		: _OwnerHUD()
+		, _BlueBorder(nullptr)
+		, _RedBorder(nullptr)
+		, _UpButtonTexture(nullptr)
+		, _DownButtonTexture(nullptr)
+		, _UIScale(1.f)
+	{}
+		/** HUD receiving name prompt clicks */
+		SLATE_ARGUMENT(TWeakObjectPtr<APlatformerHUD>, OwnerHUD)
+
+		/** blue themed border textures */
+		SLATE_ARGUMENT(const FBorderTextures*, BlueBorder)
+
+		/** red themed border textures */
+		SLATE_ARGUMENT(const FBorderTextures*, RedBorder)
+
+		/** up button texture */
+		SLATE_ARGUMENT(UTexture2D*, UpButtonTexture)
+
+		/** down button texture */
+		SLATE_ARGUMENT(UTexture2D*, DownButtonTexture)
+
+		/** scale of the 2048 pixel wide layout to the viewport */
+		SLATE_ATTRIBUTE(float, UIScale)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** shows round timer with TimeSeconds or hides it */
+	void SetRoundTimer(bool bVisible, float TimeSeconds = 0.0f);
+
+	/** shows round time modification of TimeSeconds at PosY <0, 1> or hides it */
+	void SetRoundTimeModification(bool bVisible, float TimeSeconds = 0.0f, float PosY = 0.0f);
+
+	/** shows Messages in the pooled message frames */
+	void SetMessages(const FPlatformerMessageQueue& Messages);
+
+	/** replaces summary screen messages: total time on top of the summary frame, time difference at its bottom */
+	void SetEndingMessages(const TArray<struct FPlatformerMessageData>& Messages);
+
+	/** shows "Jump or Slide" prompt, null hides it */
+	void SetInputPrompt(const FText* Text);
+
+	/** shows highscore table made of place, time and name cells of every row */
+	void SetHighscore(const TArray<FText>& Cells);
+
+	/** hides highscore table */
+	void HideHighscore();
+
+	/** shows highscore name prompt with Name's letters, CurrentLetter is highlighted and has up/down buttons */
+	void SetNamePrompt(const TArray<char>& Name, int32 CurrentLetter);
+
+	/** hides highscore name prompt */
+	void HideNamePrompt();
+
+private:
+	/** pooled frame showing one of the active messages */
+	struct FMessageFrame
+	{
+		/** whole frame, collapsed while unused */
+		TSharedPtr<SWidget> Widget;
+
+		/** background border, switched between themes */
+		TSharedPtr<SBorder> Background;
+
+		/** edge border, switched between themes */
+		TSharedPtr<SBorder> Border;
+
+		/** message text */
+		TSharedPtr<SPlatformerHUDText> Text;
+
+		/** slot of the frame, moved to the message position */
+		SPlatformerHUDCanvas::FSlot* Slot;
+	};
+
+	/** brushes drawing one themed frame */
+	struct FFrameBrushes
+	{
+		/** tiled background */
+		FSlateBrush Background;
+
+		/** border corners and edges, for small frames */
+		FSlateBrush SmallBorder;
+
+		/** border corners and edges, for full size frames */
+		FSlateBrush Border;
+
+		/** horizontal separator line */
+		FSlateBrush Separator;
+	};
+
+	/** sets up FrameBrushes from BorderTextures */
+	static void MakeFrameBrushes(const FBorderTextures& BorderTextures, FFrameBrushes& FrameBrushes);
+
+	/** font of HUD text drawn at TextScale */
+	static FSlateFontInfo GetFont(float TextScale);
+
+	/** size of the HUD font drawn at TextScale */
+	static int32 GetFontSize(float TextScale);
+
+	/** wraps Content in a blue or red frame */
+	TSharedRef<SWidget> MakeFrame(TSharedRef<SWidget> Content, bool bRedBorder, bool bSmallBorder) const;
+
+	/** text block with HUD font */
+	TSharedRef<STextBlock> MakeText(const FText& Text, float TextScale) const;
+
+	/** called when a name prompt button is clicked, forwarded to APlatformerHUD::NotifyHitBoxClick */
+	FReply OnNamePromptClicked(FName BoxName);
+
+	/** marks cached HUD widgets for repaint */
+	void InvalidateCache();
+
+	/** parts of the cached HUD, in FramesCanvas */
+	enum EFrameGroup
+	{
+		Group_EndingMessages,
+		Group_Messages,
+		Group_InputPrompt,
+		Group_NamePrompt,
+		Group_Highscore,
+	};
+
+	/** HUD receiving name prompt clicks */
+	TWeakObjectPtr<APlatformerHUD> OwnerHUD;
+
+	/** blue themed frame */
+	FFrameBrushes BlueBrushes;
+
+	/** red themed frame */
+	FFrameBrushes RedBrushes;
+
+	/** up button image */
+	FSlateBrush UpButtonBrush;
+
+	/** down button image */
+	FSlateBrush DownButtonBrush;
+
+	/** caches everything but the round timer */
+	TSharedPtr<SInvalidationPanel> CachedPanel;
+
+	/** all cached frames, frames of a group share layers so each of their textures is drawn in one batch */
+	TSharedPtr<SPlatformerHUDCanvas> FramesCanvas;
+
+	/** frames of active messages, created once and updated in place */
+	FMessageFrame MessageFrames[FPlatformerMessageQueue::Capacity];
+
+	/** round timer frame, not cached */
+	TSharedPtr<SWidget> RoundTimerFrame;
+
+	/** round timer text */
+	TSharedPtr<SPlatformerHUDTimeText> RoundTimerText;
+
+	/** round time modification frame, not cached */
+	TSharedPtr<SWidget> RoundTimeModificationFrame;
+
+	/** round time modification text */
+	TSharedPtr<SPlatformerHUDTimeText> RoundTimeModificationText;
+
+	/** slot of RoundTimeModificationFrame, moved while it animates */
+	SPlatformerHUDCanvas::FSlot* RoundTimeModificationSlot;
+};
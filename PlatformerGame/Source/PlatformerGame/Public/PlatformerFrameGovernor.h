@@ -0,0 +1,61 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Tickable.h"
+
+/**
+ * Holds a target frame rate on slower machines by stepping scalability knobs owned by the game:
+ * round timer refresh rate, then reduced rate foot IK ground queries.
+ * Watches smoothed game and render thread time, degrades a step after a second over budget
+ * and restores a step after a few seconds well under it. Tick rate is capped at the target.
+ */
+class FPlatformerFrameGovernor : public FTickableGameObject
+{
+public:
+	FPlatformerFrameGovernor();
+	virtual ~FPlatformerFrameGovernor();
+
+	/** sets frame rate to hold, 0 disables the governor and restores every knob */
+	void SetTargetFrameRate(int32 InTargetFrameRate);
+
+	/** caps t.MaxFPS at the target frame rate, for when something else wrote it meanwhile */
+	void ApplyFrameRateCap() const;
+
+	/** returns frame rate being held, 0 if disabled */
+	int32 GetTargetFrameRate() const
+	{
+		return TargetFrameRate;
+	}
+
+	/** returns current step, 0 is full quality */
+	int32 GetLevel() const
+	{
+		return Level;
+	}
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+private:
+	/** sets knobs of NewLevel */
+	void ApplyLevel(int32 NewLevel);
+
+	/** frame rate being held, 0 if disabled */
+	int32 TargetFrameRate;
+
+	/** current step, index to the knob table */
+	int32 Level;
+
+	/** smoothed CPU frame time in milliseconds */
+	float AverageFrameTimeMs;
+
+	/** seconds spent over budget since last step */
+	float OverBudgetTime;
+
+	/** seconds spent well under budget since last step */
+	float UnderBudgetTime;
+};
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "PlatformerFrameGovernor.h"
 #include "PlatformerGameUserSettings.generated.h"
 
 UCLASS()
@@ -9,7 +10,7 @@ class UPlatformerGameUserSettings : public UGameUserSettings
 {
 	GENERATED_UCLASS_BODY()
 
-	/** Applies all current user settings to the game and saves to permanent storage (e.g. file), optionally checking for command line overrides. */
+	/** Applies user settings to the game and saves to permanent storage (e.g. file), optionally checking for command line overrides. Video mode is only changed if resolution or window mode changed. */
 	virtual void ApplySettings(bool bCheckForCommandLineOverrides) override;
 
 	/** Checks if any user settings is different from current */
@@ -30,9 +31,30 @@ class UPlatformerGameUserSettings : public UGameUserSettings
 	/** Checks if the Inverted Mouse user setting is different from current */
 	bool IsSoundVolumeDirty() const;
 
+	/** Getter for the frame rate held by the frame governor, 0 if disabled */
+	int32 GetTargetFrameRate() const
+	{
+		return TargetFrameRate;
+	}
+
+	void SetTargetFrameRate(int32 InFrameRate)
+	{
+		TargetFrameRate = InFrameRate;
+	}
+
+	/** Checks if the target frame rate is different from the one held by the frame governor */
+	bool IsTargetFrameRateDirty() const;
+
 private:
 
 	/** Holds the music volume */
 	UPROPERTY(config)
 	float SoundVolume;
+
+	/** Holds the frame rate the frame governor keeps, 0 disables it */
+	UPROPERTY(config)
+	int32 TargetFrameRate;
+
+	/** steps game scalability knobs to hold TargetFrameRate, created when first applied */
+	TSharedPtr<FPlatformerFrameGovernor> FrameGovernor;
 };
\ No newline at end of file
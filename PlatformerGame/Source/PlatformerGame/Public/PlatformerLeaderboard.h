@@ -0,0 +1,111 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "PlatformerLeaderboard.generated.h"
+
+/** Single highscore entry */
+USTRUCT(BlueprintType)
+struct FPlatformerHighscore
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** round time in seconds, lower is better */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Highscore)
+	float Time;
+
+	/** name entered by the player */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Highscore)
+	FString Name;
+
+	FPlatformerHighscore()
+		: Time(0.0f)
+	{
+	}
+
+	FPlatformerHighscore(float InTime, const FString& InName)
+		: Time(InTime)
+		, Name(InName)
+	{
+	}
+};
+
+/** Best K highscores, kept sorted by time so submitting a run only binary searches and shifts the tail */
+USTRUCT(BlueprintType)
+struct FPlatformerLeaderboard
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** entries sorted by time, best first */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Highscore)
+	TArray<FPlatformerHighscore> Entries;
+
+	/** max number of entries kept */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Highscore)
+	int32 MaxEntries;
+
+	FPlatformerLeaderboard()
+		: MaxEntries(10)
+	{
+	}
+
+	/** returns place (0 is best) Time would take, INDEX_NONE if it wouldn't make it to the board */
+	int32 GetRank(float Time) const;
+
+	/** inserts Time and Name at their place, returns the place or INDEX_NONE if the time wasn't good enough */
+	int32 Submit(float Time, const FString& Name);
+
+	/** changes capacity, dropping the worst entries if needed */
+	void SetMaxEntries(int32 InMaxEntries);
+
+private:
+	/** returns index of the first entry worse than Time, so equal times keep their older entries first */
+	int32 UpperBound(float Time) const;
+};
+
+/** Blueprint access to FPlatformerLeaderboard */
+UCLASS()
+class UPlatformerLeaderboardLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_UCLASS_BODY()
+
+	/** creates leaderboard with at most MaxEntries best times of Times and Names */
+	UFUNCTION(BlueprintPure, Category=Highscore)
+	static FPlatformerLeaderboard MakeLeaderboard(const TArray<float>& Times, const TArray<FString>& Names, int32 MaxEntries = 10);
+
+	/** submits a run, returns its place (0 is best) or -1 if it didn't make it to the board */
+	UFUNCTION(BlueprintCallable, Category=Highscore)
+	static int32 SubmitHighscore(UPARAM(ref) FPlatformerLeaderboard& Leaderboard, float Time, const FString& Name);
+
+	/** returns place (0 is best) Time would take, -1 if it wouldn't make it to the board */
+	UFUNCTION(BlueprintPure, Category=Highscore)
+	static int32 GetHighscoreRank(const FPlatformerLeaderboard& Leaderboard, float Time);
+
+	/** splits leaderboard into times and names, best first */
+	UFUNCTION(BlueprintPure, Category=Highscore)
+	static void BreakLeaderboard(const FPlatformerLeaderboard& Leaderboard, TArray<float>& OutTimes, TArray<FString>& OutNames);
+
+	/** shows highscore screen with leaderboard entries */
+	UFUNCTION(BlueprintCallable, Category=HUD, meta=(WorldContext="WorldContextObject"))
+	static void ShowLeaderboard(UObject* WorldContextObject, const FPlatformerLeaderboard& Leaderboard);
+
+	/** returns highscores saved with SaveHighscore, read from disk on first use */
+	UFUNCTION(BlueprintCallable, Category=Highscore)
+	static FPlatformerLeaderboard GetSavedLeaderboard();
+
+	/** adds a run to saved highscores, written in the background; returns its place (0 is best) or -1 */
+	UFUNCTION(BlueprintCallable, Category=Highscore)
+	static int32 SaveHighscore(float Time, const FString& Name);
+
+	/** starts reading saved records in the background, so LoadBestCheckpointTimes doesn't have to read the disk */
+	static void PreloadRecords();
+
+	/** returns best checkpoint times saved with SaveRun, read from disk on first use unless preloaded */
+	static void LoadBestCheckpointTimes(TArray<float>& OutTimes);
+
+	/** saves checkpoint times of a finished run in the background */
+	static void SaveRun(const TArray<float>& CheckpointTimes);
+
+	/** sorts InTimes with their InNames, keeping at most MaxScores best entries */
+	static void SortHighscores(const TArray<float>& InTimes, const TArray<FString>& InNames, TArray<float>& OutTimes, TArray<FString>& OutNames, int32 MaxScores);
+};
@@ -0,0 +1,74 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "PlatformerLevelStreamer.generated.h"
+
+/**
+ * Streams street sections in ahead of the runner and out again once they are far behind.
+ * The runner only ever moves along +X, so sections are kept in config in street order and
+ * their X extents are learned from level bounds the first time each of them is loaded.
+ * Sublevels not listed in Sections (lights, effects, background) are left alone.
+ */
+UCLASS(config=Game)
+class UPlatformerLevelStreamer : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+	/**
+	 * Requests loading and unloading of sections around the runner.
+	 *
+	 * @param ViewCenterX		X of the middle of the visible area
+	 * @param ViewHalfWidth		half of the visible area width along X
+	 * @param PawnLocation		runner location
+	 * @param PawnVelocity		runner velocity
+	 */
+	void UpdateStreaming(float ViewCenterX, float ViewHalfWidth, const FVector& PawnLocation, const FVector& PawnVelocity);
+
+protected:
+	/** short package names of streamed sections, in street order */
+	UPROPERTY(config)
+	TArray<FName> Sections;
+
+	/** seconds of running covered by sections loaded ahead of the visible area */
+	UPROPERTY(config)
+	float LoadAheadTime;
+
+	/** distance ahead of the visible area that is always loaded, covers jumps and level start */
+	UPROPERTY(config)
+	float LoadAheadDistance;
+
+	/** distance behind the visible area after which sections are unloaded */
+	UPROPERTY(config)
+	float UnloadBehindDistance;
+
+private:
+	/** runtime state of one section */
+	struct FSectionState
+	{
+		/** streaming level of the section, null if the current world doesn't have it */
+		TWeakObjectPtr<ULevelStreaming> StreamingLevel;
+
+		/** X extents, valid once bBoundsKnown is set */
+		float MinX;
+		float MaxX;
+
+		/** if MinX and MaxX were read from the loaded level */
+		bool bBoundsKnown;
+	};
+
+	/** finds streaming levels of Sections in World */
+	void InitSections(UWorld* World);
+
+	/** reads X extents of the section if it's loaded */
+	static void UpdateBounds(FSectionState& Section);
+
+	/** sets streaming flags of the section, returns if anything changed */
+	static bool SetSectionLoaded(FSectionState& Section, bool bShouldBeLoaded, bool bBlockOnLoad);
+
+	/** world SectionStates were found in */
+	TWeakObjectPtr<UWorld> SectionsWorld;
+
+	/** state of every entry of Sections */
+	TArray<FSectionState> SectionStates;
+};
@@ -0,0 +1,43 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Loads a map package and its initially loaded sublevels in the background before travelling to it.
+ * Loaded packages are kept alive through the garbage collection done by travel, so LoadMap finds
+ * them in memory instead of reading them from disk, and released once the next map is loaded.
+ */
+class FPlatformerMapPreloader : public FGCObject
+{
+public:
+	/** returns the preloader */
+	static FPlatformerMapPreloader& Get();
+
+	/** starts async loading of MapPackageName (e.g. /Game/Maps/Platformer_StreetSection), does nothing if already requested */
+	void Preload(const FString& MapPackageName);
+
+	/** releases all preloaded packages */
+	void Reset();
+
+	// Begin FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	// End FGCObject interface
+
+private:
+	FPlatformerMapPreloader();
+
+	/** async load of a single package */
+	void RequestPackage(const FString& PackageName);
+
+	/** called when a package finished loading, requests sublevels of loaded maps */
+	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	/** called after travel, the new map owns the packages now */
+	void OnPostLoadMap();
+
+	/** packages requested so far */
+	TSet<FString> RequestedPackages;
+
+	/** worlds (or packages without one) loaded so far, referenced until travel is done */
+	TArray<UObject*> LoadedObjects;
+};
@@ -0,0 +1,127 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "PlatformerLeaderboard.h"
+#include "Async.h"
+
+/**
+ * Versioned binary log of finished runs and highscores, kept in Saved/SaveGames/PlatformerRecords.bin.
+ * Records are appended on a pool thread so saving never stalls the game thread. The log is read on a pool
+ * thread once Preload is called rather than at startup, first access only waits for it if it hasn't finished,
+ * and the log is rewritten as a snapshot of best splits and leaderboard once it grows.
+ */
+class FPlatformerRecordStore
+{
+public:
+	/** returns the store */
+	static FPlatformerRecordStore& Get();
+
+	/** creates a store keeping its log in InFilename, the game uses Get instead; call WaitForWriteTasks before destroying it */
+	explicit FPlatformerRecordStore(const FString& InFilename);
+
+	/** starts reading the log on a pool thread, so first access doesn't hit the disk on the game thread */
+	void Preload();
+
+	/** returns best time of every checkpoint, -1 for checkpoints never reached */
+	const TArray<float>& GetBestSplits();
+
+	/** returns saved highscores */
+	const FPlatformerLeaderboard& GetLeaderboard();
+
+	/** records checkpoint times of a finished run */
+	void AddRun(const TArray<float>& Splits);
+
+	/** records a highscore, returns its place or INDEX_NONE if it didn't make it to the board */
+	int32 AddHighscore(float Time, const FString& Name);
+
+	/** writes pending records on the calling thread */
+	void Flush();
+
+	/** waits for writes started on pool threads, gives up after a few seconds so a stalled pool can't block exit */
+	void WaitForWriteTasks();
+
+private:
+	/** type tag written before every record */
+	enum ERecordType
+	{
+		Record_Run = 1,
+		Record_Highscore = 2,
+	};
+
+	/** data waiting to be written by the pool thread */
+	struct FPendingWrite
+	{
+		/** bytes to write */
+		TArray<uint8> Data;
+
+		/** if Data is a snapshot replacing the whole file, otherwise it's appended */
+		bool bReplaceFile;
+	};
+
+	/** reads the log on first access */
+	void EnsureLoaded();
+
+	/** merges Splits into BestSplits */
+	void ApplyRun(const TArray<float>& Splits);
+
+	/** serializes run record */
+	static void WriteRun(FArchive& Ar, const TArray<float>& Splits);
+
+	/** serializes highscore record */
+	static void WriteHighscore(FArchive& Ar, float Time, const FString& Name);
+
+	/** queues Data for the pool thread */
+	void QueueWrite(TArray<uint8>& Data, bool bReplaceFile);
+
+	/** queues snapshot of current state replacing the log */
+	void QueueSnapshot();
+
+	/** writes all queued data, called on pool thread */
+	void WritePending();
+
+	/** magic number at the start of the file */
+	static const uint32 FileMagic = 0x53524C50;
+
+	/** bumped when the record layout changes, files with other versions are discarded */
+	static const int32 FileVersion = 1;
+
+	/** log records after which the log is rewritten as a snapshot */
+	static const int32 MaxRecordsBeforeCompaction = 64;
+
+	/** max checkpoints read from one run record, guards against corrupted counts */
+	static const int32 MaxSplits = 1024;
+
+	/** seconds WaitForWriteTasks waits for each write task */
+	static const int32 MaxWriteTaskWaitSeconds = 5;
+
+	/** log file path */
+	FString Filename;
+
+	/** if the log was read */
+	bool bLoaded;
+
+	/** read of the log started by Preload, returns if the file was read */
+	TFuture<bool> LoadTask;
+
+	/** contents of the log, filled by LoadTask and released once parsed */
+	TArray<uint8> LoadedData;
+
+	/** best time of every checkpoint */
+	TArray<float> BestSplits;
+
+	/** best highscores */
+	FPlatformerLeaderboard Leaderboard;
+
+	/** records in the log since last snapshot */
+	int32 NumLogRecords;
+
+	/** writes queued on the game thread, drained by one pool thread at a time */
+	TQueue<FPendingWrite, EQueueMode::Spsc> PendingWrites;
+
+	/** held while draining PendingWrites */
+	FCriticalSection WriteCritical;
+
+	/** pool thread tasks started by QueueWrite, finished ones are dropped when the next one starts */
+	TArray<TFuture<void>> WriteTasks;
+};
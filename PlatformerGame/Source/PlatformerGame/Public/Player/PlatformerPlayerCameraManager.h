@@ -34,6 +34,10 @@ protected:
 	/** calculates camera Z axis offset dependent on player pawn movement */
 	float CalcCameraOffsetZ(float DeltaTime);
 
+	/** streams street sections around the visible area */
+	UPROPERTY()
+	class UPlatformerLevelStreamer* LevelStreamer;
+
 private:
 
 	/** fixed maximal camera distance from player pawn ; used for zoom */
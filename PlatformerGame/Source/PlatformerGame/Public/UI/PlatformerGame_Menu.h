@@ -9,6 +9,9 @@ class APlatformerGame_Menu : public AGameMode
 {
 	GENERATED_UCLASS_BODY()
 
+	/** starts streaming in-game HUD assets while the menu is shown */
+	virtual void BeginPlay() override;
+
 	/** skip it, menu doesn't require player start or pawn */
 	virtual void RestartPlayer(class AController* NewPlayer) override;
 };
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Engine/StreamableManager.h"
+#include "PlatformerLeaderboard.h"
 #include "PlatformerHUD.generated.h"
 
 struct FPlatformerMessageData
@@ -28,6 +30,58 @@ struct FPlatformerMessageData
 	bool bRedBorder;
 };
 
+/**
+ * Fixed capacity pool of HUD messages, kept sorted by expiry time so expired messages are always at the front.
+ * When full, the message that would expire first makes room for the new one. Slots are reused in place,
+ * so once their strings have grown adding a message doesn't allocate.
+ */
+class FPlatformerMessageQueue
+{
+public:
+	/** max number of messages displayed at once */
+	static const int32 Capacity = 16;
+
+	FPlatformerMessageQueue();
+
+	/** copies Message with Params into a free slot, returns false if an identical message was already added at the same time */
+	bool Add(const FString& Message, const FPlatformerMessageData& Params);
+
+	/** removes messages expired at CurrTime, returns how many were removed */
+	int32 RemoveExpired(float CurrTime);
+
+	/** returns number of messages */
+	int32 Num() const
+	{
+		return Count;
+	}
+
+	/** returns message at Index, 0 expires first */
+	const FPlatformerMessageData& operator[](int32 Index) const
+	{
+		check(Index >= 0 && Index < Count);
+		return Messages[Order[Index]];
+	}
+
+private:
+	/** returns message at Index, 0 expires first */
+	FPlatformerMessageData& At(int32 Index)
+	{
+		return Messages[Order[Index]];
+	}
+
+	/** removes message that expires first, its slot is kept for the next message */
+	void PopFront();
+
+	/** message storage, messages are never moved between slots so their strings keep their buffers */
+	FPlatformerMessageData Messages[Capacity];
+
+	/** slots of Messages sorted by expiry time, the first Count are in use and the rest are free */
+	int32 Order[Capacity];
+
+	/** number of messages */
+	int32 Count;
+};
+
 struct FBorderTextures
 {
 	/** border texture */
@@ -65,8 +119,8 @@ public:
 	/** main HUD update loop */
 	virtual void DrawHUD() override;
 
-	/** used to add new message to ActiveMessages array */
-	void AddMessage(FString Message, float DisplayDuration = 1.f, float PosX = 0.5f, float PosY = 0.5f, float TextScale = 1.f, bool bRedBorder = false);
+	/** used to add new message to ActiveMessages queue */
+	void AddMessage(const FString& Message, float DisplayDuration = 1.f, float PosX = 0.5f, float PosY = 0.5f, float TextScale = 1.f, bool bRedBorder = false);
 
 	void NotifyRoundTimeModified(float DeltaTime);
 
@@ -76,38 +130,59 @@ public:
 	/** sets the data and shows the highscore */
 	void ShowHighscore(TArray<float> Times, TArray<FString> Names);
 
+	/** shows the highscore with leaderboard entries */
+	void ShowLeaderboard(const FPlatformerLeaderboard& Leaderboard);
+
 	/** hides highscore */
 	void HideHighscore();
 
 	/** shows highscore prompt, calls HighscoreNameAccepted blueprint implementable event when user is done */
 	void ShowHighscorePrompt();
 
+	/** starts streaming HUD textures, requested when the menu map loads so they're resident before the first round */
+	static void RequestAssets(FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** releases streamed HUD textures, called on module shutdown */
+	static void ReleaseAssets();
+
+	// Begin Actor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// End Actor interface
+
 protected:
 
-	/** used to display main game timer - top middle of the screen */
-	void DisplayRoundTimer();
+	/** updates main game timer - top middle of the screen */
+	void UpdateRoundTimer(bool bVisible);
 
-	void DisplayRoundTimeModification();
+	/** updates round time modification flying from the timer */
+	void UpdateRoundTimeModification(bool bVisible);
 
-	/** used to display active messages and removing expired ones */
-	void DrawActiveMessages();
+	/** removes expired messages and pushes active ones to the widget when they change */
+	void UpdateActiveMessages();
 
-	/** used to display single text message with specified parameters */
-	void DrawMessage(FString Message, float PosX, float PosY, float TextScale, FLinearColor TextColor, bool bRedBorder=false);
+	/** points texture members at streamed in HUD textures, returns false if some aren't loaded yet */
+	bool ResolveAssets();
 
-	/** draws 3x3 border with tiled background*/
-	void DrawBorder(float PosX, float PosY, float Width, float Height, float BorderScale, FBorderTextures& BorderTextures);
+	/** called when HUD textures finished streaming */
+	void OnAssetsLoaded();
+
+	/** creates HUDWidget and adds it to the viewport, textures have to be resolved */
+	void CreateHUDWidget();
 
-	/** draws high score entry prompt */
-	void DrawHighscoreEntryPrompt();
+	/** draws bare round timer and summary picture while HUD textures are streaming in */
+	void DrawFallback(class APlatformerGameMode* MyGame);
 
-	/** draws high score */
-	void DrawHighscore();
+	/** returns current UI scale, bound to HUDWidget */
+	float GetUIScale() const;
+
+	/** draws 3x3 border with tiled background*/
+	void DrawBorder(float PosX, float PosY, float Width, float Height, float BorderScale, FBorderTextures& BorderTextures);
 
 private:
 
 	/** array of messages that should be displayed on screen for a fixed time */
-	TArray<struct FPlatformerMessageData> ActiveMessages;
+	FPlatformerMessageQueue ActiveMessages;
 
 	/** summary messages */
 	TArray<struct FPlatformerMessageData> EndingMessages;
@@ -116,8 +191,8 @@ private:
 
 	float RoundTimeModificationTime;
 
-	/** roboto Light 48p font */
-	UFont* HUDFont;
+	/** real time the round timer was last pushed to the widget, -1 while hidden */
+	float RoundTimerUpdateTime;
 
 	/** blue themed border textures */
 	FBorderTextures BlueBorder;
@@ -149,9 +224,47 @@ private:
 	/** if highscore is currently displayed */
 	uint32 bHighscoreActive : 1;
 
-	/** highscore times */
-	TArray<float> HighscoreTimes;
+	/** highscore entries, in display order */
+	TArray<FPlatformerHighscore> HighscoreEntries;
+
+	/** highscore table cells (place, time, name for every row), rebuilt only when the table changes */
+	TArray<FText> HighscoreCells;
+
+	/** "Jump or Slide" prompts: while waiting, when finished and in any other state */
+	FText InputMessageWaiting;
+	FText InputMessageFinished;
+	FText InputMessageDefault;
+
+	/** retained HUD widgets, only told about changes */
+	TSharedPtr<class SPlatformerHUDWidget> HUDWidget;
+
+	/** viewport container of HUDWidget */
+	TSharedPtr<class SWeakWidget> HUDWidgetContainer;
+
+	/** input prompt currently shown by HUDWidget */
+	const FText* ShownInputPrompt;
+
+	/** if ActiveMessages changed since they were pushed to HUDWidget */
+	uint32 bMessagesDirty : 1;
+
+	/** if EndingMessages changed since they were pushed to HUDWidget */
+	uint32 bEndingMessagesDirty : 1;
+
+	/** if HUDWidget shows EndingMessages */
+	uint32 bEndingMessagesShown : 1;
+
+	/** if highscore table changed since it was pushed to HUDWidget */
+	uint32 bHighscoreDirty : 1;
+
+	/** if HUDWidget shows highscore table */
+	uint32 bHighscoreShown : 1;
+
+	/** if name prompt changed since it was pushed to HUDWidget */
+	uint32 bNamePromptDirty : 1;
+
+	/** if HUDWidget shows name prompt */
+	uint32 bNamePromptShown : 1;
 
-	/** highscore names */
-	TArray<FString> HighscoreNames;
+	/** rebuilds HighscoreCells from HighscoreEntries */
+	void BuildHighscoreCells();
 };
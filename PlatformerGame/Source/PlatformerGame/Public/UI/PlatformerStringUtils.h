@@ -0,0 +1,16 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** String helpers for HUD text that is replaced often and shouldn't allocate once its buffer has grown */
+struct FPlatformerStringUtils
+{
+	/**
+	 * Copies Source into Dest, keeping Dest's buffer if it's big enough.
+	 * Plain assignment reallocates the buffer to the exact length of Source, so it allocates whenever the length changes.
+	 *
+	 * @param Dest		string to overwrite
+	 * @param Source	string to copy
+	 */
+	static void AssignInPlace(FString& Dest, const FString& Source);
+};
@@ -0,0 +1,24 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** Formats times in mm:ss.sss into caller provided buffers, used by the HUD every frame and by DescribeTime */
+struct FPlatformerTimeFormat
+{
+	/** buffer size needed by Format: sign, mm:ss.sss and terminator */
+	static const int32 MaxLength = 11;
+
+	/**
+	 * Writes TimeSeconds as [+-]mm:ss.sss to Buffer, minutes wrap every hour.
+	 *
+	 * @param TimeSeconds	time to format
+	 * @param bShowSign		if + or - should be written before the time
+	 * @param Buffer		destination, null terminated
+	 * @param BufferSize	size of Buffer, at least MaxLength
+	 * @return number of characters written, without terminator
+	 */
+	static int32 Format(float TimeSeconds, bool bShowSign, TCHAR* Buffer, int32 BufferSize);
+
+	/** returns TimeSeconds formatted as a new string */
+	static FString Describe(float TimeSeconds, bool bShowSign);
+};
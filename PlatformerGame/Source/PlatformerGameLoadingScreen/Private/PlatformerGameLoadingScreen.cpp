@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "PlatformerGameLoadingScreen.h"
+#include "PlatformerTrace.h"
 
 #include "SlateBasics.h"
 #include "SlateExtras.h"
@@ -14,7 +15,35 @@ struct FPlatformerGameLoadingScreenBrush : public FSlateDynamicImageBrush, publi
 	FPlatformerGameLoadingScreenBrush( const FName InTextureName, const FVector2D& InImageSize )
 		: FSlateDynamicImageBrush( InTextureName, InImageSize )
 	{
-		ResourceObject = LoadObject<UObject>( NULL, *InTextureName.ToString() );
+		// only use the texture if it's already in memory, RequestTexture streams it in otherwise
+		ResourceObject = FindObject<UObject>( NULL, *InTextureName.ToString() );
+	}
+
+	/** starts async loading of the texture package, Brush picks the texture up when it arrives */
+	static void RequestTexture(const TSharedRef<FPlatformerGameLoadingScreenBrush>& Brush)
+	{
+		if (Brush->ResourceObject)
+		{
+			return;
+		}
+
+		const FString ObjectPath = Brush->GetResourceName().ToString();
+		TWeakPtr<FPlatformerGameLoadingScreenBrush> WeakBrush = Brush;
+		LoadPackageAsync(FPackageName::ObjectPathToPackageName(ObjectPath), FLoadPackageAsyncDelegate::CreateLambda(
+			[WeakBrush, ObjectPath](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+			{
+				TSharedPtr<FPlatformerGameLoadingScreenBrush> PinnedBrush = WeakBrush.Pin();
+				if (PinnedBrush.IsValid() && Result == EAsyncLoadingResult::Succeeded)
+				{
+					PinnedBrush->ResourceObject = FindObject<UObject>(NULL, *ObjectPath);
+				}
+			}));
+	}
+
+	/** true once the texture is loaded */
+	bool IsTextureLoaded() const
+	{
+		return ResourceObject != nullptr;
 	}
 
 	virtual void AddReferencedObjects(FReferenceCollector& Collector)
@@ -38,16 +67,27 @@ public:
 
 		//since we are not using game styles here, just load one image
 		LoadingScreenBrush = MakeShareable( new FPlatformerGameLoadingScreenBrush( LoadingScreenName, FVector2D(1920,1080) ) );
+		FPlatformerGameLoadingScreenBrush::RequestTexture(LoadingScreenBrush.ToSharedRef());
 
 		ChildSlot
 		[
 			SNew(SOverlay)
+			// plain black until the image is streamed in
+			+SOverlay::Slot()
+			.HAlign(HAlign_Fill)
+			.VAlign(VAlign_Fill)
+			[
+				SNew(SBorder)
+				.BorderImage(FCoreStyle::Get().GetBrush("GenericWhiteBox"))
+				.BorderBackgroundColor(FLinearColor::Black)
+			]
 			+SOverlay::Slot()
 			.HAlign(HAlign_Fill)
 			.VAlign(VAlign_Fill)
 			[
 				SNew(SImage)
 				.Image(LoadingScreenBrush.Get())
+				.Visibility(this, &SPlatformerLoadingScreen::GetImageVisibility)
 			]
 			+SOverlay::Slot()
 			.HAlign(HAlign_Fill)
@@ -67,13 +107,18 @@ public:
 	}
 
 private:
+	EVisibility GetImageVisibility() const
+	{
+		return LoadingScreenBrush->IsTextureLoaded() ? EVisibility::HitTestInvisible : EVisibility::Hidden;
+	}
+
 	EVisibility GetLoadIndicatorVisibility() const
 	{
 		return GetMoviePlayer()->IsLoadingFinished() ? EVisibility::Collapsed : EVisibility::Visible;
 	}
 	
 	/** loading screen image brush */
-	TSharedPtr<FSlateDynamicImageBrush> LoadingScreenBrush;
+	TSharedPtr<FPlatformerGameLoadingScreenBrush> LoadingScreenBrush;
 };
 
 class FPlatformerGameLoadingScreenModule : public IPlatformerGameLoadingScreenModule
@@ -81,9 +126,11 @@ class FPlatformerGameLoadingScreenModule : public IPlatformerGameLoadingScreenMo
 public:
 	virtual void StartupModule() override
 	{		
-		// Load for cooker reference
-		LoadObject<UObject>(NULL, TEXT("/Game/UI/Menu/LoadingScreen.LoadingScreen") ); 
+		// this module is loaded first, so the trace covers the rest of startup
+		FPlatformerTrace::Startup();
+		PLATFORMER_TRACE_SCOPE(TEXT("LoadingScreen.StartupModule"));
 
+		// the image is streamed in by the loading screen itself, DefaultGame.ini makes sure it's cooked
 		if (IsMoviePlayerEnabled())
 		{
 			CreateLoadingScreen();
@@ -91,6 +138,11 @@ public:
 	}
 
 
+	virtual void ShutdownModule() override
+	{
+		FPlatformerTrace::Shutdown();
+	}
+
 	virtual bool IsGameModule() const override
 	{
 		return true;
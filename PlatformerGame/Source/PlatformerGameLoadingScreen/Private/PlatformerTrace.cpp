@@ -0,0 +1,257 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PlatformerGameLoadingScreen.h"
+#include "PlatformerTrace.h"
+#include "CoreUObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPlatformerTrace, Log, All);
+
+bool FPlatformerTrace::bEnabled = false;
+
+namespace PlatformerTrace
+{
+	/** single begin, end or instant event */
+	struct FEvent
+	{
+		/** event name */
+		FName Name;
+
+		/** what the event is about (e.g. map name), written to args so names stay a fixed set */
+		FString Detail;
+
+		/** FPlatformTime::Seconds when recorded */
+		double Time;
+
+		/** Chrome trace phase: B, E or i */
+		TCHAR Phase;
+	};
+
+	/** events recorded by one thread */
+	struct FThreadBuffer
+	{
+		/** recording thread */
+		uint32 ThreadId;
+
+		/** if the recording thread is the game thread */
+		bool bGameThread;
+
+		/** recorded events, in order */
+		TArray<FEvent> Events;
+
+		/** only contended while the trace is written */
+		FCriticalSection Critical;
+	};
+
+	/** TLS slot holding FThreadBuffer of the calling thread */
+	static uint32 TlsSlot = 0;
+
+	/** buffers of all threads that recorded anything, freed by Shutdown */
+	static TArray<FThreadBuffer*> Buffers;
+
+	/** held while adding to Buffers */
+	static FCriticalSection BuffersCritical;
+
+	/** delegates bound by Startup */
+	static FDelegateHandle PreLoadMapHandle;
+	static FDelegateHandle PostLoadMapHandle;
+	static FDelegateHandle SyncLoadHandle;
+
+	/** if a LoadMap event was begun and not ended yet, only touched on the game thread */
+	static bool bLoadMapEventOpen = false;
+
+	/** returns buffer of the calling thread, creating it on first use */
+	static FThreadBuffer& GetThreadBuffer()
+	{
+		FThreadBuffer* Buffer = (FThreadBuffer*)FPlatformTLS::GetTlsValue(TlsSlot);
+		if (Buffer == nullptr)
+		{
+			Buffer = new FThreadBuffer();
+			Buffer->ThreadId = FPlatformTLS::GetCurrentThreadId();
+			Buffer->bGameThread = IsInGameThread();
+			Buffer->Events.Reserve(1024);
+			FPlatformTLS::SetTlsValue(TlsSlot, Buffer);
+
+			FScopeLock Lock(&BuffersCritical);
+			Buffers.Add(Buffer);
+		}
+		return *Buffer;
+	}
+
+	/** escapes String for a JSON string */
+	static FString EscapeString(const FString& String)
+	{
+		return String.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+	}
+
+	static void OnPreLoadMap(const FString& MapName)
+	{
+		// PostLoadMap isn't broadcast when LoadMap fails, close the event of the failed load here
+		if (bLoadMapEventOpen)
+		{
+			FPlatformerTrace::EndEvent();
+		}
+
+		static const FName LoadMapName(TEXT("LoadMap"));
+		FPlatformerTrace::BeginEvent(LoadMapName, MapName);
+		bLoadMapEventOpen = true;
+	}
+
+	static void OnPostLoadMap()
+	{
+		if (bLoadMapEventOpen)
+		{
+			FPlatformerTrace::EndEvent();
+			bLoadMapEventOpen = false;
+		}
+	}
+
+	static void OnSyncLoadPackage(const FString& PackageName)
+	{
+		static const FName SyncLoadName(TEXT("SyncLoad"));
+		FPlatformerTrace::InstantEvent(SyncLoadName, PackageName);
+	}
+
+	static void WriteTraceCommand(const TArray<FString>& Args)
+	{
+		if (!FPlatformerTrace::IsEnabled())
+		{
+			UE_LOG(LogPlatformerTrace, Warning, TEXT("Platformer trace isn't recording, start the game with -PlatformerTrace"));
+			return;
+		}
+		FPlatformerTrace::WriteFile(Args.Num() > 0 ? Args[0] : FString());
+	}
+
+	static FAutoConsoleCommand WriteTraceCmd(
+		TEXT("Platformer.WriteTrace"),
+		TEXT("Writes startup and loading events recorded with -PlatformerTrace as Chrome trace JSON. Optional argument: file name."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&WriteTraceCommand));
+}
+
+void FPlatformerTrace::Startup()
+{
+#if PLATFORMER_TRACE_ENABLED
+	if (bEnabled || !FParse::Param(FCommandLine::Get(), TEXT("PlatformerTrace")))
+	{
+		return;
+	}
+
+	PlatformerTrace::TlsSlot = FPlatformTLS::AllocTlsSlot();
+	PlatformerTrace::PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddStatic(&PlatformerTrace::OnPreLoadMap);
+	PlatformerTrace::PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMap.AddStatic(&PlatformerTrace::OnPostLoadMap);
+	PlatformerTrace::SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddStatic(&PlatformerTrace::OnSyncLoadPackage);
+	bEnabled = true;
+#endif
+}
+
+void FPlatformerTrace::Shutdown()
+{
+	if (bEnabled)
+	{
+		WriteFile();
+
+		FCoreUObjectDelegates::PreLoadMap.Remove(PlatformerTrace::PreLoadMapHandle);
+		FCoreUObjectDelegates::PostLoadMap.Remove(PlatformerTrace::PostLoadMapHandle);
+		FCoreUObjectDelegates::OnSyncLoadPackage.Remove(PlatformerTrace::SyncLoadHandle);
+		bEnabled = false;
+		PlatformerTrace::bLoadMapEventOpen = false;
+
+		// other threads stop recording once bEnabled is cleared, their TLS values go with the slot
+		{
+			FScopeLock BuffersLock(&PlatformerTrace::BuffersCritical);
+			for (PlatformerTrace::FThreadBuffer* Buffer : PlatformerTrace::Buffers)
+			{
+				delete Buffer;
+			}
+			PlatformerTrace::Buffers.Empty();
+		}
+		FPlatformTLS::SetTlsValue(PlatformerTrace::TlsSlot, nullptr);
+		FPlatformTLS::FreeTlsSlot(PlatformerTrace::TlsSlot);
+	}
+}
+
+void FPlatformerTrace::AddEvent(TCHAR Phase, const FName Name, const FString* Detail)
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	PlatformerTrace::FThreadBuffer& Buffer = PlatformerTrace::GetThreadBuffer();
+	PlatformerTrace::FEvent Event;
+	Event.Name = Name;
+	Event.Time = FPlatformTime::Seconds();
+	Event.Phase = Phase;
+	if (Detail)
+	{
+		Event.Detail = *Detail;
+	}
+
+	FScopeLock Lock(&Buffer.Critical);
+	Buffer.Events.Add(MoveTemp(Event));
+}
+
+void FPlatformerTrace::BeginEvent(const FName Name)
+{
+	AddEvent(TEXT('B'), Name);
+}
+
+void FPlatformerTrace::BeginEvent(const FName Name, const FString& Detail)
+{
+	AddEvent(TEXT('B'), Name, &Detail);
+}
+
+void FPlatformerTrace::EndEvent()
+{
+	AddEvent(TEXT('E'), NAME_None);
+}
+
+void FPlatformerTrace::InstantEvent(const FName Name)
+{
+	AddEvent(TEXT('i'), Name);
+}
+
+void FPlatformerTrace::InstantEvent(const FName Name, const FString& Detail)
+{
+	AddEvent(TEXT('i'), Name, &Detail);
+}
+
+bool FPlatformerTrace::WriteFile(const FString& Filename)
+{
+	const FString OutFilename = Filename.Len() > 0 ? Filename : FPaths::ProfilingDir() / TEXT("PlatformerTrace.json");
+	const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+
+	FString Json = TEXT("{\"traceEvents\":[\n");
+	bool bFirstEvent = true;
+	{
+		FScopeLock BuffersLock(&PlatformerTrace::BuffersCritical);
+		for (PlatformerTrace::FThreadBuffer* Buffer : PlatformerTrace::Buffers)
+		{
+			FScopeLock Lock(&Buffer->Critical);
+
+			const FString ThreadName = Buffer->bGameThread ? FString(TEXT("GameThread")) : FString::Printf(TEXT("Thread %u"), Buffer->ThreadId);
+			Json += FString::Printf(TEXT("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}"),
+				bFirstEvent ? TEXT("") : TEXT(",\n"), ProcessId, Buffer->ThreadId, *ThreadName);
+			bFirstEvent = false;
+
+			for (const PlatformerTrace::FEvent& Event : Buffer->Events)
+			{
+				// timestamps are in microseconds since the process started
+				const double Timestamp = (Event.Time - GStartTime) * 1000000.0;
+				const FString Args = Event.Detail.Len() > 0 ? FString::Printf(TEXT(",\"args\":{\"detail\":\"%s\"}"), *PlatformerTrace::EscapeString(Event.Detail)) : FString();
+				Json += FString::Printf(TEXT(",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.1f,\"pid\":%u,\"tid\":%u%s%s}"),
+					Event.Phase == TEXT('E') ? TEXT("") : *PlatformerTrace::EscapeString(Event.Name.ToString()), Event.Phase, Timestamp,
+					ProcessId, Buffer->ThreadId, Event.Phase == TEXT('i') ? TEXT(",\"s\":\"t\"") : TEXT(""), *Args);
+			}
+		}
+	}
+	Json += TEXT("\n]}\n");
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutFilename))
+	{
+		UE_LOG(LogPlatformerTrace, Warning, TEXT("Failed to write platformer trace to %s"), *OutFilename);
+		return false;
+	}
+
+	UE_LOG(LogPlatformerTrace, Log, TEXT("Platformer trace written to %s"), *OutFilename);
+	return true;
+}
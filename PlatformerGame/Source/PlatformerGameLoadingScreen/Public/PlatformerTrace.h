@@ -0,0 +1,100 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** tracing is compiled out of shipping builds */
+#define PLATFORMER_TRACE_ENABLED !UE_BUILD_SHIPPING
+
+/**
+ * Records startup and loading phases as begin/end events and writes them in Chrome trace_event format
+ * (open in chrome://tracing). Recording is enabled with -PlatformerTrace on the command line, the trace is
+ * written to Saved/Profiling/PlatformerTrace.json on exit or with the Platformer.WriteTrace console command.
+ * Every thread records into its own buffer, so events from the loading screen and pool threads don't contend.
+ * Lives in the loading screen module since that's loaded before everything else in the game.
+ */
+class PLATFORMERGAMELOADINGSCREEN_API FPlatformerTrace
+{
+public:
+	/** enables recording if requested on the command line and hooks map loading and sync package loads */
+	static void Startup();
+
+	/** writes the trace if recording, stops and frees recorded events */
+	static void Shutdown();
+
+	/** returns if events are recorded */
+	static bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	/** starts an event on the calling thread, closed by the next EndEvent on the same thread */
+	static void BeginEvent(const FName Name);
+
+	/** starts an event with Detail in its args, so Name can stay fixed while e.g. the loaded map changes */
+	static void BeginEvent(const FName Name, const FString& Detail);
+
+	/** ends last event started on the calling thread */
+	static void EndEvent();
+
+	/** records an event without duration on the calling thread */
+	static void InstantEvent(const FName Name);
+
+	/** records an event without duration with Detail in its args */
+	static void InstantEvent(const FName Name, const FString& Detail);
+
+	/**
+	 * Writes recorded events as Chrome trace JSON.
+	 *
+	 * @param Filename	destination, Saved/Profiling/PlatformerTrace.json if empty
+	 * @return true if the file was written
+	 */
+	static bool WriteFile(const FString& Filename = FString());
+
+private:
+	/** records an event of Phase (B, E or i) on the calling thread, Detail is optional */
+	static void AddEvent(TCHAR Phase, const FName Name, const FString* Detail = nullptr);
+
+	/** if events are recorded */
+	static bool bEnabled;
+};
+
+/** Records an event for the lifetime of the scope */
+struct FPlatformerTraceScope
+{
+	FPlatformerTraceScope(const FName Name)
+		: bStarted(FPlatformerTrace::IsEnabled())
+	{
+		if (bStarted)
+		{
+			FPlatformerTrace::BeginEvent(Name);
+		}
+	}
+
+	/** only creates the FName when recording */
+	FPlatformerTraceScope(const TCHAR* Name)
+		: bStarted(FPlatformerTrace::IsEnabled())
+	{
+		if (bStarted)
+		{
+			FPlatformerTrace::BeginEvent(FName(Name));
+		}
+	}
+
+	~FPlatformerTraceScope()
+	{
+		if (bStarted)
+		{
+			FPlatformerTrace::EndEvent();
+		}
+	}
+
+private:
+	/** if BeginEvent was recorded, so EndEvent is only recorded with it */
+	bool bStarted;
+};
+
+#if PLATFORMER_TRACE_ENABLED
+	#define PLATFORMER_TRACE_SCOPE(Name) FPlatformerTraceScope ANONYMOUS_VARIABLE(PlatformerTraceScope_)(Name)
+#else
+	#define PLATFORMER_TRACE_SCOPE(Name)
+#endif